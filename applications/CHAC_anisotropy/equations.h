@@ -85,15 +85,15 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
      std::vector<modelResidual<dim> > & modelResidualsList,
-     dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+     dealii::Point<dim, scalarType> q_point_loc) const {
 
 //c
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 //n
-scalarvalueType n = modelVariablesList[1].scalarValue;
-scalargradType nx = modelVariablesList[1].scalarGrad;
+scalarvalueType n = modelVariablesList[1].scalarValue();
+scalargradType nx = modelVariablesList[1].scalarGrad();
 
 // anisotropy code
 scalarvalueType normgradn = std::sqrt(nx.norm_square());
@@ -144,7 +144,7 @@ modelResidualsList[1].scalarGradResidual = rnxV;
 // can be accessed by "this->currentFieldIndex".
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
-    modelResidual<dim> & modelRes, dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+    modelResidual<dim> & modelRes, dealii::Point<dim, scalarType> q_point_loc) const {
 
 }
 
@@ -161,17 +161,17 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-    const dealii::VectorizedArray<double> & JxW_value,
-    dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+    const scalarType & JxW_value,
+    dealii::Point<dim, scalarType> q_point_loc) {
 
 scalarvalueType total_energy_density = constV(0.0);
 
 //c
-scalarvalueType c = modelVarList[0].scalarValue;
+scalarvalueType c = modelVarList[0].scalarValue();
 
 //n1
-scalarvalueType n = modelVarList[1].scalarValue;
-scalargradType nx = modelVarList[1].scalarGrad;
+scalarvalueType n = modelVarList[1].scalarValue();
+scalargradType nx = modelVarList[1].scalarGrad();
 
 scalarvalueType f_chem = (constV(1.0)-hV)*faV + hV*fbV;
 
@@ -60,15 +60,15 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The chemical potential and its derivatives (names here should match those in the macros above)
-scalarvalueType mu = modelVariablesList[1].scalarValue;
-scalargradType mux = modelVariablesList[1].scalarGrad;
+scalarvalueType mu = modelVariablesList[1].scalarValue();
+scalargradType mux = modelVariablesList[1].scalarGrad();
 
 // Residuals for the equation to evolve the concentration (names here should match those in the macros above)
 modelResidualsList[0].scalarValueResidual = rcV;
@@ -98,7 +98,7 @@ modelResidualsList[1].scalarGradResidual = rmuxV;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 }
 
 // =================================================================================
@@ -114,17 +114,17 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVariablesList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 scalarvalueType total_energy_density = constV(0.0);
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The chemical potential and its derivatives (names here should match those in the macros above)
-scalarvalueType mu = modelVariablesList[1].scalarValue;
-scalargradType mux = modelVariablesList[1].scalarGrad;
+scalarvalueType mu = modelVariablesList[1].scalarValue();
+scalargradType mux = modelVariablesList[1].scalarGrad();
 
 // The homogenous free energy
 scalarvalueType f_chem = fV;
@@ -38,6 +38,13 @@
 #define timeFinal 10000.0
 #define timeIncrements 2000000
 
+// Set to "true" to choose the time steps adaptively from an embedded error estimate,
+// starting from timeStep. The chemical potential "mu" is recomputed from "c" at each
+// stage instead of being integrated in time.
+#define adaptiveTimeStepping false
+#define timeStepRelTol 1.0e-3
+#define auxiliaryFields "mu"
+
 // =================================================================================
 // Set the output parameters
 // =================================================================================
@@ -22,6 +22,12 @@
 #define need_val_residual {true, true, true, true, true, true}
 #define need_grad_residual {true, true, true, true, true, true}
 
+// Flags for whether the value, gradient, and Hessian are needed in the residual eqn
+// for the left-hand-side of the iterative solver (only used if imexFields is set)
+#define need_val_LHS {false, false, false, false, false, false}
+#define need_grad_LHS {true, true, false, false, false, false}
+#define need_hess_LHS {false, false, false, false, false, false}
+
 // =================================================================================
 // Define the model parameters and the residual equations
 // =================================================================================
@@ -106,24 +112,24 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The chemical potential and its derivatives (names here should match those in the macros above)
-scalargradType mux = modelVariablesList[1].scalarGrad;
+scalargradType mux = modelVariablesList[1].scalarGrad();
 
 // The order parameters and their derivatives (names here should match those in the macros above)
-scalarvalueType n1 = modelVariablesList[2].scalarValue;
-scalargradType n1x = modelVariablesList[2].scalarGrad;
-scalarvalueType n2 = modelVariablesList[3].scalarValue;
-scalargradType n2x = modelVariablesList[3].scalarGrad;
-scalarvalueType n3 = modelVariablesList[4].scalarValue;
-scalargradType n3x = modelVariablesList[4].scalarGrad;
-scalarvalueType n4 = modelVariablesList[5].scalarValue;
-scalargradType n4x = modelVariablesList[5].scalarGrad;
+scalarvalueType n1 = modelVariablesList[2].scalarValue();
+scalargradType n1x = modelVariablesList[2].scalarGrad();
+scalarvalueType n2 = modelVariablesList[3].scalarValue();
+scalargradType n2x = modelVariablesList[3].scalarGrad();
+scalarvalueType n3 = modelVariablesList[4].scalarValue();
+scalargradType n3x = modelVariablesList[4].scalarGrad();
+scalarvalueType n4 = modelVariablesList[5].scalarValue();
+scalargradType n4x = modelVariablesList[5].scalarGrad();
 
 // Residuals for the equation to evolve the concentration (names here should match those in the macros above)
 modelResidualsList[0].scalarValueResidual = rcV;
@@ -158,10 +164,28 @@ modelResidualsList[5].scalarGradResidual = rn4xV;
 // are multiple elliptic equations, conditional statements should be used to ensure
 // that the correct residual is being submitted. The index of the field being solved
 // can be accessed by "this->currentFieldIndex".
+//
+// With imexFields set to "c:mu", this function gives the gradient terms of the
+// Cahn-Hilliard equation treated implicitly (the order parameters stay explicit).
+// The residual equation is given by "modelRes.fieldIndex" and the field whose change
+// is in "modelVariablesList" by "modelRes.changedFieldIndex".
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
+
+modelRes.scalarValueResidual = constV(0.0);
+
+if (modelRes.fieldIndex == 1){
+	// The change in the concentration
+	scalargradType Dcx = modelVariablesList[0].scalarGrad();
+	modelRes.scalarGradResidual = KcV*Dcx;
+}
+else {
+	// The change in the chemical potential
+	scalargradType Dmux = modelVariablesList[1].scalarGrad();
+	modelRes.scalarGradResidual = constV(timeStep)*McV*Dmux;
+}
 
 }
 
@@ -178,22 +202,22 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVariablesList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n1 = modelVariablesList[2].scalarValue;
-scalargradType n1x = modelVariablesList[2].scalarGrad;
-scalarvalueType n2 = modelVariablesList[3].scalarValue;
-scalargradType n2x = modelVariablesList[3].scalarGrad;
-scalarvalueType n3 = modelVariablesList[4].scalarValue;
-scalargradType n3x = modelVariablesList[4].scalarGrad;
-scalarvalueType n4 = modelVariablesList[5].scalarValue;
-scalargradType n4x = modelVariablesList[5].scalarGrad;
+scalarvalueType n1 = modelVariablesList[2].scalarValue();
+scalargradType n1x = modelVariablesList[2].scalarGrad();
+scalarvalueType n2 = modelVariablesList[3].scalarValue();
+scalargradType n2x = modelVariablesList[3].scalarGrad();
+scalarvalueType n3 = modelVariablesList[4].scalarValue();
+scalargradType n3x = modelVariablesList[4].scalarGrad();
+scalarvalueType n4 = modelVariablesList[5].scalarValue();
+scalargradType n4x = modelVariablesList[5].scalarGrad();
 
 // The homogenous free energy
 scalarvalueType f_chem = (constV(1.0)-hV)*faV + hV*fbV + wV*gV;
@@ -61,6 +61,10 @@
 #define timeFinal 10000.0
 #define timeIncrements 20000
 
+// Set to "c:mu" to treat the gradient terms of the Cahn-Hilliard equation
+// semi-implicitly (IMEX), the order parameters are always explicit
+#define imexFields ""
+
 // =================================================================================
 // Set the output parameters
 // =================================================================================
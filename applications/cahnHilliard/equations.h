@@ -22,6 +22,12 @@
 #define need_val_residual {true, true}
 #define need_grad_residual {true, true}
 
+// Flags for whether the value, gradient, and Hessian are needed in the residual eqn
+// for the left-hand-side of the iterative solver (only used if imexFields is set)
+#define need_val_LHS {false, false}
+#define need_grad_LHS {true, true}
+#define need_hess_LHS {false, false}
+
 // =================================================================================
 // Define the model parameters and the residual equations
 // =================================================================================
@@ -60,14 +66,14 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The chemical potential and its derivatives (names here should match those in the macros above)
-scalargradType mux = modelVariablesList[1].scalarGrad;
+scalargradType mux = modelVariablesList[1].scalarGrad();
 
 // Residuals for the equation to evolve the concentration (names here should match those in the macros above)
 modelResidualsList[0].scalarValueResidual = rcV;
@@ -94,10 +100,30 @@ modelResidualsList[1].scalarGradResidual = rmuxV;
 // are multiple elliptic equations, conditional statements should be used to ensure
 // that the correct residual is being submitted. The index of the field being solved
 // can be accessed by "this->currentFieldIndex".
+//
+// With imexFields set to "c:mu", this function gives the linear (gradient) terms
+// treated implicitly. The residual equation is given by "modelRes.fieldIndex" and
+// the field whose change is in "modelVarList" by "modelRes.changedFieldIndex": the
+// LHS of the mu equation is taken with respect to the change in c, and the LHS of
+// the c equation with respect to the change in mu.
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
+
+modelRes.scalarValueResidual = constV(0.0);
+
+if (modelRes.fieldIndex == 1){
+	// The change in the concentration
+	scalargradType Dcx = modelVarList[0].scalarGrad();
+	modelRes.scalarGradResidual = constV(KcV)*Dcx;
+}
+else {
+	// The change in the chemical potential
+	scalargradType Dmux = modelVarList[1].scalarGrad();
+	modelRes.scalarGradResidual = constV(McV*timeStep)*Dmux;
+}
+
 }
 
 // =================================================================================
@@ -113,13 +139,13 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVariablesList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 scalarvalueType total_energy_density = constV(0.0);
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The homogenous free energy
 scalarvalueType f_chem = fV;
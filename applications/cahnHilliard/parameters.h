@@ -38,6 +38,10 @@
 #define timeFinal 100.0
 #define timeIncrements 100000
 
+// Set to "c:mu" to treat the gradient terms semi-implicitly (IMEX), which allows
+// much larger time steps than the explicit scheme on fine meshes
+#define imexFields ""
+
 // =================================================================================
 // Set the output parameters
 // =================================================================================
@@ -60,15 +60,15 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVariablesList[0].vectorGrad;
+vectorgradType ux = modelVariablesList[0].vectorGrad();
 vectorgradType Rux;
 
-dealii::VectorizedArray<double> sfts[dim][dim];
+scalarType sfts[dim][dim];
 
-dealii::VectorizedArray<double> dist, a;
+scalarType dist, a;
 
 // Radius of the inclusion
 a = constV(10.0);
@@ -83,7 +83,7 @@ for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		if (i == j){
 
-			sfts[i][j] = 0.01 * (0.5+ 0.5*( constV(1.0) - std::exp(-20.0*(dist-a)))/ (constV(1.0)+std::exp(-20.0*(dist-a))));
+			sfts[i][j] = 0.01 * (0.5+ 0.5*vectorizedMath::tanh(constV(10.0)*(dist-a)));
 
 		}
 		else {
@@ -94,7 +94,7 @@ for (unsigned int i=0; i<dim; i++){
 
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i])-sfts[i][j];
@@ -133,14 +133,14 @@ modelResidualsList[0].vectorGradResidual = Rux;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVarList[0].vectorGrad;
+vectorgradType ux = modelVarList[0].vectorGrad();
 vectorgradType Rux;
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i]);
@@ -173,14 +173,14 @@ modelRes.vectorGradResidual = Rux;
 // density are added to the "energy_components" variable (index 0: chemical energy,
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
-void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const dealii::VectorizedArray<double> & JxW_value, dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const scalarType & JxW_value, dealii::Point<dim, scalarType> q_point_loc) {
 
 	//u
-	vectorgradType ux = modelVarList[0].vectorGrad;
+	vectorgradType ux = modelVarList[0].vectorGrad();
 
-	dealii::VectorizedArray<double> sfts[dim][dim];
+	scalarType sfts[dim][dim];
 
-	dealii::VectorizedArray<double> dist;
+	scalarType dist;
 
 	dist = std::sqrt((q_point_loc[0]-constV(0.0))*(q_point_loc[0]-constV(0.0))
 						+(q_point_loc[1]-constV(0.0))*(q_point_loc[1]-constV(0.0))
@@ -190,7 +190,7 @@ void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim>
 		for (unsigned int j=0; j<dim; j++){
 			if (i == j){
 
-				sfts[i][j] = 0.01 * (0.5+ 0.5*( constV(1.0) - std::exp(-20.0*(dist-constV(10.0))))/ (constV(1.0)+std::exp(-20.0*(dist-constV(10.0)))));
+				sfts[i][j] = 0.01 * (0.5+ 0.5*vectorizedMath::tanh(constV(10.0)*(dist-constV(10.0))));
 
 			}
 			else {
@@ -201,7 +201,7 @@ void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim>
 
 
 	//compute strain tensor
-	dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+	scalarType E[dim][dim], S[dim][dim];
 	for (unsigned int i=0; i<dim; i++){
 		for (unsigned int j=0; j<dim; j++){
 			E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i])-sfts[i][j];
@@ -22,6 +22,13 @@
 #define need_val_residual {true,true,true,true,true,true,true,true,true,true}
 #define need_grad_residual {true,true,true,true,true,true,true,true,true,true}
 
+// Flags for the variables whose residual vanishes where the variable vanishes (the
+// order parameters). The evaluation of such a variable is skipped on the cell batches
+// where it is below sparseVariableTolerance, so the cost of the evaluation scales with
+// the number of grains present in each cell batch. The order parameters are still
+// stored as dense fields and read on every cell batch.
+#define sparse_var {true,true,true,true,true,true,true,true,true,true}
+
 // =================================================================================
 // Define the model parameters and the residual equations
 // =================================================================================
@@ -54,20 +61,26 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
-dealii::VectorizedArray<double> fnV = constV(0.0);
+scalarType fnV = constV(0.0);
 scalargradType nx;
 
+// Sum of the squares of the order parameters, the interaction term of each order parameter
+// with the others is computed from it instead of a loop over the pairs
+// The order parameters that vanish on the cell batch (inactive) are skipped
+scalarType sum_n2 = constV(0.0);
+for (unsigned int i=0; i<num_var; i++){
+	if (!modelVariablesList[i].isActive()) continue;
+	sum_n2 += modelVariablesList[i].scalarValue()*modelVariablesList[i].scalarValue();
+}
+
 for (unsigned int i=0; i<num_var; i++){
-	fnV = - modelVariablesList[i].scalarValue + modelVariablesList[i].scalarValue*modelVariablesList[i].scalarValue*modelVariablesList[i].scalarValue;
-	nx = modelVariablesList[i].scalarGrad;
-	for (unsigned int j=0; j<num_var; j++){
-		if (i != j){
-			fnV += constV(2.0*alpha) * modelVariablesList[i].scalarValue * modelVariablesList[j].scalarValue*modelVariablesList[j].scalarValue;
-		}
-	}
-	modelResidualsList[i].scalarValueResidual = modelVariablesList[i].scalarValue-constV(timeStep*MnV)*fnV;
+	if (!modelVariablesList[i].isActive()) continue;
+	scalarType n = modelVariablesList[i].scalarValue();
+	fnV = - n + n*n*n + constV(2.0*alpha) * n * (sum_n2 - n*n);
+	nx = modelVariablesList[i].scalarGrad();
+	modelResidualsList[i].scalarValueResidual = n-constV(timeStep*MnV)*fnV;
 	modelResidualsList[i].scalarGradResidual = constV(-timeStep*KnV*MnV)*nx;
 }
 
@@ -92,7 +105,7 @@ for (unsigned int i=0; i<num_var; i++){
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 }
 
 // =================================================================================
@@ -108,8 +121,8 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 	scalarvalueType total_energy_density = constV(0.0);
 
 
@@ -52,6 +52,33 @@
 // Set the number of time steps between remeshing operations
 #define skipRemeshingSteps 1000
 
+// =================================================================================
+// Set the active region parameters
+// =================================================================================
+// Set the flag determining if only the cells near the grain boundaries are evaluated
+// between full evaluations (every activeRegionUpdateSteps time steps)
+#define activeRegionSkipping false
+#define activeRegionUpdateSteps 10
+
+// Set the fields used to find the grain boundaries and the window of values inside them
+#define activeRegionFields {0,1,2,3,4,5,6,7,8,9}
+#define activeRegionWindowMax {0.999,0.999,0.999,0.999,0.999,0.999,0.999,0.999,0.999,0.999}
+#define activeRegionWindowMin {0.001,0.001,0.001,0.001,0.001,0.001,0.001,0.001,0.001,0.001}
+
+// =================================================================================
+// Set the grain remapping parameters
+// =================================================================================
+// Set the flag determining if the grains are tracked and moved to another order
+// parameter when they come too close to a grain of the same order parameter
+#define grainRemapping false
+#define skipGrainRemappingSteps 100
+
+// Set the order parameters of the grains, the value above which a cell belongs to a
+// grain and the smallest distance between two grains of the same order parameter
+#define grainRemappingFields {0,1,2,3,4,5,6,7,8,9}
+#define grainThreshold 0.01
+#define grainBufferDistance 5.0
+
 // =================================================================================
 // Set the time step parameters
 // =================================================================================
@@ -61,14 +61,14 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVariablesList[0].vectorGrad;
+vectorgradType ux = modelVariablesList[0].vectorGrad();
 vectorgradType Rux;
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i]);
@@ -107,14 +107,14 @@ modelResidualsList[0].vectorGradResidual = Rux;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVarList[0].vectorGrad;
+vectorgradType ux = modelVarList[0].vectorGrad();
 vectorgradType Rux;
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i]);
@@ -148,17 +148,17 @@ modelRes.vectorGradResidual = Rux;
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 
 	scalarvalueType total_energy_density = constV(0.0);
-	vectorgradType ux = modelVarList[0].vectorGrad;
+	vectorgradType ux = modelVarList[0].vectorGrad();
 	scalarvalueType f_chem = constV(0.0);
 
 	scalarvalueType f_grad = constV(0.0);
 
 	//compute E2=(E-E0)
-	dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+	scalarType E[dim][dim], S[dim][dim];
 
 	for (unsigned int i=0; i<dim; i++){
 	  for (unsigned int j=0; j<dim; j++){
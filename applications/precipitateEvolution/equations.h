@@ -112,27 +112,27 @@ double sfts_const3[3][3]={{0.0225, 0.0069,0},{0.0069,0.0305,0},{0,0,-0.00270}};
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The first order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n1 = modelVariablesList[1].scalarValue;
-scalargradType n1x = modelVariablesList[1].scalarGrad;
+scalarvalueType n1 = modelVariablesList[1].scalarValue();
+scalargradType n1x = modelVariablesList[1].scalarGrad();
 
 // The second order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n2 = modelVariablesList[2].scalarValue;
-scalargradType n2x = modelVariablesList[2].scalarGrad;
+scalarvalueType n2 = modelVariablesList[2].scalarValue();
+scalargradType n2x = modelVariablesList[2].scalarGrad();
 
 
 // The third order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n3 = modelVariablesList[3].scalarValue;
-scalargradType n3x = modelVariablesList[3].scalarGrad;
+scalarvalueType n3 = modelVariablesList[3].scalarValue();
+scalargradType n3x = modelVariablesList[3].scalarGrad();
 
 // The derivative of the displacement vector (names here should match those in the macros above)
-vectorgradType ux = modelVariablesList[4].vectorGrad;
+vectorgradType ux = modelVariablesList[4].vectorGrad();
 vectorgradType ruxV;
 
 vectorhessType uxx;
@@ -147,11 +147,11 @@ for (unsigned int i=0; i<dim; i++){
 }
 
 if (c_dependent_misfit == true){
-	uxx = modelVariablesList[4].vectorHess;
+	uxx = modelVariablesList[4].vectorHess();
 }
 
 // Calculate the stress-free transformation strain and its derivatives at the quadrature point
-dealii::Tensor<2, problemDIM, dealii::VectorizedArray<double> > sfts1, sfts1c, sfts1cc, sfts2, sfts2c, sfts2cc, sfts3, sfts3c, sfts3cc;
+dealii::Tensor<2, problemDIM, scalarType> sfts1, sfts1c, sfts1cc, sfts2, sfts2c, sfts2cc, sfts3, sfts3c, sfts3cc;
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -173,7 +173,7 @@ for (unsigned int j=0; j<dim; j++){
 }
 
 //compute E2=(E-E0)
-dealii::VectorizedArray<double> E2[dim][dim], S[dim][dim];
+scalarType E2[dim][dim], S[dim][dim];
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -185,10 +185,10 @@ for (unsigned int j=0; j<dim; j++){
 //compute stress
 //S=C*(E-E0)
 // Compute stress tensor (which is equal to the residual, Rux)
-dealii::VectorizedArray<double> CIJ_combined[CIJ_tensor_size][CIJ_tensor_size];
+scalarType CIJ_combined[CIJ_tensor_size][CIJ_tensor_size];
 
 if (n_dependent_stiffness == true){
-dealii::VectorizedArray<double> sum_hV;
+scalarType sum_hV;
 sum_hV = h1V+h2V+h3V;
 for (unsigned int i=0; i<2*dim-1+dim/3; i++){
 	  for (unsigned int j=0; j<2*dim-1+dim/3; j++){
@@ -211,9 +211,9 @@ for (unsigned int j=0; j<dim; j++){
 }
 
 // Compute one of the stress terms in the order parameter chemical potential, nDependentMisfitACp = C*(E-E0)*(E0_p*Hn)
-dealii::VectorizedArray<double> nDependentMisfitAC1=constV(0.0);
-dealii::VectorizedArray<double> nDependentMisfitAC2=constV(0.0);
-dealii::VectorizedArray<double> nDependentMisfitAC3=constV(0.0);
+scalarType nDependentMisfitAC1=constV(0.0);
+scalarType nDependentMisfitAC2=constV(0.0);
+scalarType nDependentMisfitAC3=constV(0.0);
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -228,10 +228,10 @@ nDependentMisfitAC2*=-hn2V;
 nDependentMisfitAC3*=-hn3V;
 
 // Compute the other stress term in the order parameter chemical potential, heterMechACp = 0.5*Hn*(C_beta-C_alpha)*(E-E0)*(E-E0)
-dealii::VectorizedArray<double> heterMechAC1=constV(0.0);
-dealii::VectorizedArray<double> heterMechAC2=constV(0.0);
-dealii::VectorizedArray<double> heterMechAC3=constV(0.0);
-dealii::VectorizedArray<double> S2[dim][dim];
+scalarType heterMechAC1=constV(0.0);
+scalarType heterMechAC2=constV(0.0);
+scalarType heterMechAC3=constV(0.0);
+scalarType S2[dim][dim];
 
 if (n_dependent_stiffness == true){
 //computeStress<dim>(CIJ_diff, E2, S2);
@@ -252,7 +252,7 @@ heterMechAC1 = 0.5*hn1V*heterMechAC1;
 scalargradType grad_mu_el;
 
 if (c_dependent_misfit == true){
-	dealii::VectorizedArray<double> E3[dim][dim], S3[dim][dim];
+	scalarType E3[dim][dim], S3[dim][dim];
 
 	for (unsigned int i=0; i<dim; i++){
 		for (unsigned int j=0; j<dim; j++){
@@ -333,29 +333,29 @@ modelResidualsList[4].vectorGradResidual = ruxV;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //n1
-scalarvalueType n1 = modelVariablesList[0].scalarValue;
+scalarvalueType n1 = modelVariablesList[0].scalarValue();
 
 //n2
-scalarvalueType n2 = modelVariablesList[1].scalarValue;
+scalarvalueType n2 = modelVariablesList[1].scalarValue();
 
 
 //n3
-scalarvalueType n3 = modelVariablesList[2].scalarValue;
+scalarvalueType n3 = modelVariablesList[2].scalarValue();
 
 //u
-vectorgradType ux = modelVariablesList[3].vectorGrad;
+vectorgradType ux = modelVariablesList[3].vectorGrad();
 vectorgradType ruxV;
 
 // Take advantage of E being simply 0.5*(ux + transpose(ux)) and use the dealii "symmetrize" function
-dealii::Tensor<2, dim, dealii::VectorizedArray<double> > E;
+dealii::Tensor<2, dim, scalarType> E;
 E = symmetrize(ux);
 
 // Compute stress tensor (which is equal to the residual, Rux)
 if (n_dependent_stiffness == true){
-	dealii::Tensor<2, CIJ_tensor_size, dealii::VectorizedArray<double> > CIJ_combined;
+	dealii::Tensor<2, CIJ_tensor_size, scalarType> CIJ_combined;
 	CIJ_combined = CIJ_list[0]*(constV(1.0)-h1V-h2V-h3V) + CIJ_list[1]*(h1V+h2V+h3V);
 
 	computeStress<dim>(CIJ_combined, E, ruxV);
@@ -381,29 +381,29 @@ modelRes.vectorGradResidual = ruxV;
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 
 scalarvalueType total_energy_density = constV(0.0);
 
 //c
-scalarvalueType c = modelVarList[0].scalarValue;
+scalarvalueType c = modelVarList[0].scalarValue();
 
 //n1
-scalarvalueType n1 = modelVarList[1].scalarValue;
-scalargradType n1x = modelVarList[1].scalarGrad;
+scalarvalueType n1 = modelVarList[1].scalarValue();
+scalargradType n1x = modelVarList[1].scalarGrad();
 
 //n2
-scalarvalueType n2 = modelVarList[2].scalarValue;
-scalargradType n2x = modelVarList[2].scalarGrad;
+scalarvalueType n2 = modelVarList[2].scalarValue();
+scalargradType n2x = modelVarList[2].scalarGrad();
 
 
 //n3
-scalarvalueType n3 = modelVarList[3].scalarValue;
-scalargradType n3x = modelVarList[3].scalarGrad;
+scalarvalueType n3 = modelVarList[3].scalarValue();
+scalargradType n3x = modelVarList[3].scalarGrad();
 
 //u
-vectorgradType ux = modelVarList[4].vectorGrad;
+vectorgradType ux = modelVarList[4].vectorGrad();
 
 scalarvalueType f_chem = (constV(1.0)-(h1V+h2V+h3V))*faV + (h1V+h2V+h3V)*fbV;
 
@@ -430,7 +430,7 @@ for (int i=0; i<dim; i++){
 
 
 // Calculate the stress-free transformation strain and its derivatives at the quadrature point
-dealii::Tensor<2, problemDIM, dealii::VectorizedArray<double> > sfts1, sfts1c, sfts1cc, sfts2, sfts2c, sfts2cc, sfts3, sfts3c, sfts3cc;
+dealii::Tensor<2, problemDIM, scalarType> sfts1, sfts1c, sfts1cc, sfts2, sfts2c, sfts2cc, sfts3, sfts3c, sfts3cc;
 
 for (unsigned int i=0; i<dim; i++){
   for (unsigned int j=0; j<dim; j++){
@@ -452,7 +452,7 @@ for (unsigned int i=0; i<dim; i++){
 }
 
 //compute E2=(E-E0)
-dealii::VectorizedArray<double> E2[dim][dim], S[dim][dim];
+scalarType E2[dim][dim], S[dim][dim];
 
 for (unsigned int i=0; i<dim; i++){
   for (unsigned int j=0; j<dim; j++){
@@ -464,10 +464,10 @@ for (unsigned int i=0; i<dim; i++){
 
 //compute stress
 //S=C*(E-E0)
-dealii::VectorizedArray<double> CIJ_combined[2*dim-1+dim/3][2*dim-1+dim/3];
+scalarType CIJ_combined[2*dim-1+dim/3][2*dim-1+dim/3];
 
 if (n_dependent_stiffness == true){
-  dealii::VectorizedArray<double> sum_hV;
+  scalarType sum_hV;
   sum_hV = h1V+h2V+h3V;
   for (unsigned int i=0; i<2*dim-1+dim/3; i++){
 	  for (unsigned int j=0; j<2*dim-1+dim/3; j++){
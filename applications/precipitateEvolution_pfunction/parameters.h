@@ -72,6 +72,14 @@
 // The maximum number of solver iterations per time step
 #define maxSolverIterations 1000
 
+// The preconditioner for the solver ("NONE", "JACOBI", "CHEBYSHEV" for Chebyshev-accelerated Jacobi, or
+// "MULTIGRID" for geometric multigrid with Chebyshev smoothing, which requires deal.II 8.5 or later)
+#define preconditionerType "NONE"
+
+// The initial guess for each solve ("ZERO", "LINEAR" or "QUADRATIC" extrapolation of the previous increments,
+// or "PROJECTION" onto the subspace of the last initialGuessSubspaceSize increments)
+#define implicitInitialGuess "ZERO"
+
 // =================================================================================
 // Set the output parameters
 // =================================================================================
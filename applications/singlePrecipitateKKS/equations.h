@@ -137,18 +137,18 @@ double B0 = 1.5625;
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim>> & modelVariablesList,
 												std::vector<modelResidual<dim>> & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The concentration and its derivatives (names here should match those in the macros above)
-scalarvalueType c = modelVariablesList[0].scalarValue;
-scalargradType cx = modelVariablesList[0].scalarGrad;
+scalarvalueType c = modelVariablesList[0].scalarValue();
+scalargradType cx = modelVariablesList[0].scalarGrad();
 
 // The first order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n1 = modelVariablesList[1].scalarValue;
-scalargradType n1x = modelVariablesList[1].scalarGrad;
+scalarvalueType n1 = modelVariablesList[1].scalarValue();
+scalargradType n1x = modelVariablesList[1].scalarGrad();
 
 // The derivative of the displacement vector (names here should match those in the macros above)
-vectorgradType ux = modelVariablesList[2].vectorGrad;
+vectorgradType ux = modelVariablesList[2].vectorGrad();
 vectorgradType ruxV;
 
 vectorhessType uxx;
@@ -163,7 +163,7 @@ for (unsigned int i=0; i<dim; i++){
 }
 
 if (c_dependent_misfit == true){
-	uxx = modelVariablesList[2].vectorHess;
+	uxx = modelVariablesList[2].vectorHess();
 }
 
 // Calculate the derivatives of c_beta (derivatives of c_alpha aren't needed)
@@ -174,7 +174,7 @@ cbnV = hn1V * (c_alpha - c_beta) * cbcV;
 cbcnV = (faccV * (fbccV-faccV) * hn1V)/( ((1.0-h1V)*fbccV + h1V*faccV)*((1.0-h1V)*fbccV + h1V*faccV) );  // Note: this is only true if faV and fbV are quadratic
 
 // Calculate the stress-free transformation strain and its derivatives at the quadrature point
-dealii::Tensor<2, problemDIM, dealii::VectorizedArray<double> > sfts1, sfts1c, sfts1cc, sfts1n, sfts1cn;
+dealii::Tensor<2, problemDIM, scalarType> sfts1, sfts1c, sfts1cc, sfts1n, sfts1cn;
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -196,7 +196,7 @@ for (unsigned int j=0; j<dim; j++){
 }
 
 //compute E2=(E-E0)
-dealii::VectorizedArray<double> E2[dim][dim], S[dim][dim];
+scalarType E2[dim][dim], S[dim][dim];
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -208,7 +208,7 @@ for (unsigned int j=0; j<dim; j++){
 //compute stress
 //S=C*(E-E0)
 // Compute stress tensor (which is equal to the residual, Rux)
-dealii::VectorizedArray<double> CIJ_combined[CIJ_tensor_size][CIJ_tensor_size];
+scalarType CIJ_combined[CIJ_tensor_size][CIJ_tensor_size];
 
 if (n_dependent_stiffness == true){
 for (unsigned int i=0; i<2*dim-1+dim/3; i++){
@@ -233,7 +233,7 @@ for (unsigned int j=0; j<dim; j++){
 }
 
 // Compute one of the stress terms in the order parameter chemical potential, nDependentMisfitACp = -C*(E-E0)*(E0_n)
-dealii::VectorizedArray<double> nDependentMisfitAC1=constV(0.0);
+scalarType nDependentMisfitAC1=constV(0.0);
 
 for (unsigned int i=0; i<dim; i++){
 for (unsigned int j=0; j<dim; j++){
@@ -243,8 +243,8 @@ for (unsigned int j=0; j<dim; j++){
 
 
 // Compute the other stress term in the order parameter chemical potential, heterMechACp = 0.5*Hn*(C_beta-C_alpha)*(E-E0)*(E-E0)
-dealii::VectorizedArray<double> heterMechAC1=constV(0.0);
-dealii::VectorizedArray<double> S2[dim][dim];
+scalarType heterMechAC1=constV(0.0);
+scalarType S2[dim][dim];
 
 if (n_dependent_stiffness == true){
 	computeStress<dim>(CIJ_list[1]-CIJ_list[0], E2, S2);
@@ -261,7 +261,7 @@ if (n_dependent_stiffness == true){
 scalargradType grad_mu_el;
 
 if (c_dependent_misfit == true){
-	dealii::VectorizedArray<double> E3[dim][dim], S3[dim][dim];
+	scalarType E3[dim][dim], S3[dim][dim];
 
 	for (unsigned int i=0; i<dim; i++){
 		for (unsigned int j=0; j<dim; j++){
@@ -331,22 +331,22 @@ modelResidualsList[2].vectorGradResidual = ruxV;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim>> & modelVariablesList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //n1
-scalarvalueType n1 = modelVariablesList[0].scalarValue;
+scalarvalueType n1 = modelVariablesList[0].scalarValue();
 
 //u
-vectorgradType ux = modelVariablesList[1].vectorGrad;
+vectorgradType ux = modelVariablesList[1].vectorGrad();
 vectorgradType ruxV;
 
 // Take advantage of E being simply 0.5*(ux + transpose(ux)) and use the dealii "symmetrize" function
-dealii::Tensor<2, dim, dealii::VectorizedArray<double> > E;
+dealii::Tensor<2, dim, scalarType> E;
 E = symmetrize(ux);
 
 // Compute stress tensor (which is equal to the residual, Rux)
 if (n_dependent_stiffness == true){
-	dealii::Tensor<2, CIJ_tensor_size, dealii::VectorizedArray<double> > CIJ_combined;
+	dealii::Tensor<2, CIJ_tensor_size, scalarType> CIJ_combined;
 	CIJ_combined = CIJ_list[0]*(constV(1.0)-h1V);
 	CIJ_combined += CIJ_list[1]*(h1V);
 
@@ -373,21 +373,21 @@ modelRes.vectorGradResidual = ruxV;
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim>> & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 
 scalarvalueType total_energy_density = constV(0.0);
 
 //c
-scalarvalueType c = modelVarList[0].scalarValue;
-scalargradType cx = modelVarList[0].scalarGrad;
+scalarvalueType c = modelVarList[0].scalarValue();
+scalargradType cx = modelVarList[0].scalarGrad();
 
 //n1
-scalarvalueType n1 = modelVarList[1].scalarValue;
-scalargradType n1x = modelVarList[1].scalarGrad;
+scalarvalueType n1 = modelVarList[1].scalarValue();
+scalargradType n1x = modelVarList[1].scalarGrad();
 
 //u
-vectorgradType ux = modelVarList[2].vectorGrad;
+vectorgradType ux = modelVarList[2].vectorGrad();
 
 scalarvalueType f_chem = (constV(1.0)-(h1V))*faV + (h1V)*fbV;
 
@@ -400,7 +400,7 @@ for (int i=0; i<dim; i++){
 }
 
 // Calculate the stress-free transformation strain and its derivatives at the quadrature point
-dealii::Tensor<2, problemDIM, dealii::VectorizedArray<double> > sfts1, sfts1c, sfts1cc;
+dealii::Tensor<2, problemDIM, scalarType> sfts1, sfts1c, sfts1cc;
 
 for (unsigned int i=0; i<dim; i++){
   for (unsigned int j=0; j<dim; j++){
@@ -412,7 +412,7 @@ for (unsigned int i=0; i<dim; i++){
 }
 
 //compute E2=(E-E0)
-dealii::VectorizedArray<double> E2[dim][dim], S[dim][dim];
+scalarType E2[dim][dim], S[dim][dim];
 
 for (unsigned int i=0; i<dim; i++){
   for (unsigned int j=0; j<dim; j++){
@@ -423,7 +423,7 @@ for (unsigned int i=0; i<dim; i++){
 
 //compute stress
 //S=C*(E-E0)
-dealii::VectorizedArray<double> CIJ_combined[2*dim-1+dim/3][2*dim-1+dim/3];
+scalarType CIJ_combined[2*dim-1+dim/3][2*dim-1+dim/3];
 
 if (n_dependent_stiffness == true){
   for (unsigned int i=0; i<2*dim-1+dim/3; i++){
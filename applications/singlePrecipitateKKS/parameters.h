@@ -47,9 +47,15 @@
 #define refineWindowMax {0.99}
 #define refineWindowMin {0.001}
 
+// Optionally, also refine where the gradient magnitude of the fields exceeds these values
+//#define refineGradientMin {10.0}
+
 // Set the number of time steps between remeshing operations
 #define skipRemeshingSteps 100
 
+// Optionally, remesh only when the interface has moved out of the refined zone (checked every skipRemeshingSteps)
+//#define adaptiveRemeshing true
+
 // =================================================================================
 // Set the time step parameters
 // =================================================================================
@@ -75,6 +81,14 @@
 // The maximum number of solver iterations per time step
 #define maxSolverIterations 10000
 
+// The preconditioner for the solver ("NONE", "JACOBI", "CHEBYSHEV" for Chebyshev-accelerated Jacobi, or
+// "MULTIGRID" for geometric multigrid with Chebyshev smoothing, which requires deal.II 8.5 or later)
+#define preconditionerType "NONE"
+
+// The initial guess for each solve ("ZERO", "LINEAR" or "QUADRATIC" extrapolation of the previous increments,
+// or "PROJECTION" onto the subspace of the last initialGuessSubspaceSize increments)
+#define implicitInitialGuess "ZERO"
+
 // =================================================================================
 // Set the output parameters
 // =================================================================================
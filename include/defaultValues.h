@@ -37,6 +37,14 @@
 #define numFields 1
 #endif
 
+//evaluate the cell kernels (residualRHS and energyDensity) in single precision, which doubles the number of quadrature points
+//processed per SIMD instruction. The solution, residual and invM vectors and the updates of the solution stay in double precision,
+//so the memory traffic is unchanged. Not supported with ELLIPTIC fields, since the LHS operator would also be evaluated in single
+//precision. Set at compile time, e.g. with cmake -DCMAKE_CXX_FLAGS="-DsinglePrecisionRHS=true" (default value:false)
+#ifndef singlePrecisionRHS
+#define singlePrecisionRHS false
+#endif
+
 //write output files (default value:true)
 #ifndef writeOutput 
 #define writeOutput true
@@ -62,11 +70,221 @@
 #define maxSolverIterations 1000
 #endif
 
+//preconditioner for implicit solves, "NONE", "JACOBI", "CHEBYSHEV" or "MULTIGRID" (default value:"NONE")
+#ifndef preconditionerType
+#define preconditionerType "NONE"
+#endif
+
+//degree of the Chebyshev smoother used on each multigrid level (default value:4)
+#ifndef multigridSmootherDegree
+#define multigridSmootherDegree 4
+#endif
+
+//ratio of the largest to the smallest eigenvalue damped by the multigrid smoother (default value:20.0)
+#ifndef multigridSmoothingRange
+#define multigridSmoothingRange 20.0
+#endif
+
+//degree of the Chebyshev-accelerated Jacobi preconditioner (default value:4)
+#ifndef chebyshevDegree
+#define chebyshevDegree 4
+#endif
+
+//ratio of the largest to the smallest eigenvalue targeted by the Chebyshev-accelerated Jacobi preconditioner (default value:30.0)
+#ifndef chebyshevSmoothingRange
+#define chebyshevSmoothingRange 30.0
+#endif
+
+//solve the ELLIPTIC fields by defect correction: the corrections are computed by inner solves with the LHS operator applied to single
+//precision vectors, and the residual of the outer loop is computed in double precision so the solves converge to solverTolerance. Only
+//the vectors of the inner solves are stored in single precision: the cell kernels and the mapping data stay in numberType, so the gain
+//is limited to the vector reads and writes of each iteration. The measured time per single precision iteration is printed with each solve.
+//Supports the "NONE", "JACOBI" and "CHEBYSHEV" preconditioners. (default value:false)
+#ifndef mixedPrecisionEllipticSolves
+#define mixedPrecisionEllipticSolves false
+#endif
+
+//relative tolerance of the single precision inner solves of mixedPrecisionEllipticSolves (default value:1.0e-3)
+#ifndef innerSolverTolerance
+#define innerSolverTolerance 1.0e-3
+#endif
+
+//initial guess for the increment in implicit solves, "ZERO", "LINEAR" or "QUADRATIC" (extrapolation from the previous increments)
+//or "PROJECTION" (A-orthogonal projection onto a subspace spanned by the previous increments) (default value:"ZERO")
+#ifndef implicitInitialGuess
+#define implicitInitialGuess "ZERO"
+#endif
+
+//maximum number of previous increments kept in the subspace used by the "PROJECTION" initial guess (default value:4)
+#ifndef initialGuessSubspaceSize
+#define initialGuessSubspaceSize 4
+#endif
+
+//use adaptive time steps, chosen from an embedded error estimate, for problems with only PARABOLIC fields. timeStep is
+//the initial time step, and outputs are written at the times of the output increments for timeStep. (default value:false)
+#ifndef adaptiveTimeStepping
+#define adaptiveTimeStepping false
+#endif
+
+//relative and absolute tolerances of the local error estimate for adaptiveTimeStepping (default values:1.0e-3 and 1.0e-6)
+#ifndef timeStepRelTol
+#define timeStepRelTol 1.0e-3
+#endif
+
+#ifndef timeStepAbsTol
+#define timeStepAbsTol 1.0e-6
+#endif
+
+//bounds of the time step for adaptiveTimeStepping, the simulation stops if the time step drops below minTimeStep (default values:1.0e10 and 1.0e-12)
+#ifndef maxTimeStep
+#define maxTimeStep 1.0e10
+#endif
+
+#ifndef minTimeStep
+#define minTimeStep 1.0e-12
+#endif
+
+//comma separated names of the PARABOLIC fields that are algebraic functions of the other fields (e.g. the chemical
+//potential of a split Cahn-Hilliard equation). They are recomputed at each stage for adaptiveTimeStepping. (default value:"")
+#ifndef auxiliaryFields
+#define auxiliaryFields ""
+#endif
+
+//comma separated PARABOLIC SCALAR fields advanced with the semi-implicit (IMEX) Euler scheme, with the stiff linear terms given
+//by residualLHS treated implicitly. An entry "c:mu" couples the field c to the field mu, as for a split Cahn-Hilliard equation
+//where the LHS of mu with respect to c and the LHS of c with respect to mu are composed. (default value:"")
+#ifndef imexFields
+#define imexFields ""
+#endif
+
+//relative tolerance of the linear solves of the IMEX fields (default value:1.0e-8)
+#ifndef imexSolverTolerance
+#define imexSolverTolerance 1.0e-8
+#endif
+
+//evaluate only the cells near the interfaces in the RHS. Every activeRegionUpdateSteps increments all the cells are evaluated and
+//classified: a cell is an interface cell if a value of one of the activeRegionFields lies inside (activeRegionWindowMin, activeRegionWindowMax)
+//or its values lie on both sides of that window, and a bulk cell otherwise. Until the next classification the DOFs of the interface cells
+//and of their neighbors evolve, the cells sharing a DOF with them are evaluated and the other DOFs are held fixed, so every field that
+//evolves in the bulk must be listed in activeRegionFields. (default value:false)
+#ifndef activeRegionSkipping
+#define activeRegionSkipping false
+#endif
+
+//number of increments between the classifications of the cells for activeRegionSkipping (default value:10)
+#ifndef activeRegionUpdateSteps
+#define activeRegionUpdateSteps 10
+#endif
+
+//SCALAR fields used to classify the cells for activeRegionSkipping and their bulk windows (default values:{0}, {0.001} and {0.999})
+#ifndef activeRegionFields
+#define activeRegionFields {0}
+#endif
+
+#ifndef activeRegionWindowMin
+#define activeRegionWindowMin {0.001}
+#endif
+
+#ifndef activeRegionWindowMax
+#define activeRegionWindowMax {0.999}
+#endif
+
+//track the grains of the order parameters listed in grainRemappingFields and move a grain to another of these fields when it comes
+//closer than grainBufferDistance to a grain of the same field, so that a few order parameters can represent many grains. A grain is a
+//connected region of the cells where the field exceeds grainThreshold. The grains are tracked at the start and every
+//skipGrainRemappingSteps increments. (default value:false)
+#ifndef grainRemapping
+#define grainRemapping false
+#endif
+
+//number of increments between the grain remapping steps (default value:100)
+#ifndef skipGrainRemappingSteps
+#define skipGrainRemappingSteps 100
+#endif
+
+//SCALAR fields holding the order parameters of the grains for grainRemapping (default value:{0})
+#ifndef grainRemappingFields
+#define grainRemappingFields {0}
+#endif
+
+//value of an order parameter above which a cell belongs to a grain (default value:0.01)
+#ifndef grainThreshold
+#define grainThreshold 0.01
+#endif
+
+//smallest separation of the boundary cells of two grains of the same field before one of them is remapped (default value:0.0)
+#ifndef grainBufferDistance
+#define grainBufferDistance 0.0
+#endif
+
+//remesh only when needed: every skipRemeshingSteps increments the refinement criterion is evaluated on the current mesh, and the mesh
+//is refined and coarsened only if the criterion flags a cell below maxRefinementLevel for refinement (an interface has moved out of the
+//refined zone) or after maxSkippedRemeshings checks without a remesh. Set skipRemeshingSteps small enough that an interface cannot cross
+//the refined band between two checks. Requires a window criterion such as the one of the generalized model (not KELLY, which flags cells
+//for refinement on every mesh). (default value:false)
+#ifndef adaptiveRemeshing
+#define adaptiveRemeshing false
+#endif
+
+//largest number of consecutive checks of adaptiveRemeshing without a remesh (default value:10)
+#ifndef maxSkippedRemeshings
+#define maxSkippedRemeshings 10
+#endif
+
+//repartition the mesh after adaptive refinement with the cells weighted by a modeled cost instead of balancing the number of cells.
+//A cell flagged for refinement by the refinement criterion (an interface cell) costs interfaceCellWeight times a bulk cell, and a cell
+//with hanging nodes hangingNodeCellWeight times a cell without. (default value:false)
+#ifndef weightedRepartitioning
+#define weightedRepartitioning false
+#endif
+
+//relative cost of an interface cell and of a cell with hanging nodes for weightedRepartitioning (default values:2.0 and 1.3)
+#ifndef interfaceCellWeight
+#define interfaceCellWeight 2.0
+#endif
+
+#ifndef hangingNodeCellWeight
+#define hangingNodeCellWeight 1.3
+#endif
+
+//DOF values below which a variable flagged in sparse_var (equations.h) is treated as zero on a cell batch (per-batch skipping: all
+//the lanes must vanish), where its evaluation and integration in the RHS are then skipped and residualRHS sees it as inactive (default value:1.0e-8)
+#ifndef sparseVariableTolerance
+#define sparseVariableTolerance 1.0e-8
+#endif
+
+//number of increments between checks of the solution for NaN/Inf values. Every increment is checked if value is 1, which is the default.
+#ifndef skipNaNCheckSteps
+#define skipNaNCheckSteps 1
+#endif
+
 //number of implicit solves to skip. None are skipped if value is 1, which is the default.
 #ifndef skipImplicitSolves
 #define skipImplicitSolves 1
 #endif
 
+//skip implicit solves adaptively: a solve is done only when the residual norm exceeds implicitSolveResidualThreshold times the
+//largest initial residual norm of the previous solves of the field, or after maxSkippedImplicitSolves skipped solves.
+//skipImplicitSolves is ignored when this is true. (default value:false)
+#ifndef adaptiveSkipImplicitSolves
+#define adaptiveSkipImplicitSolves false
+#endif
+
+//relative residual threshold for adaptiveSkipImplicitSolves (default value:1.0e-3)
+#ifndef implicitSolveResidualThreshold
+#define implicitSolveResidualThreshold 1.0e-3
+#endif
+
+//absolute residual norm above which adaptiveSkipImplicitSolves does a solve while the reference residual norm of the field is zero (default value:1.0e-12)
+#ifndef implicitSolveResidualFloor
+#define implicitSolveResidualFloor 1.0e-12
+#endif
+
+//maximum number of consecutive implicit solves skipped by adaptiveSkipImplicitSolves (default value:10)
+#ifndef maxSkippedImplicitSolves
+#define maxSkippedImplicitSolves 10
+#endif
+
 //number of implicit solves to skip. None are skipped if value is 1, which is the default.
 #ifndef outputCondition
 #define outputCondition "EQUAL_SPACING"
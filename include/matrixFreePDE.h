@@ -5,6 +5,7 @@
 //general headers
 #include <fstream>
 #include <sstream>
+#include <list>
 #include <iterator> // is this necessary?
 
 //dealii headers
@@ -16,61 +17,85 @@
 
  
 //define data types
+//number type of the cell kernels (the matrix free object, FEEvaluation and model variables), see singlePrecisionRHS
+#ifndef numberType
+#if singlePrecisionRHS
+typedef float numberType;
+#else
+typedef double numberType;
+#endif
+#endif
 #ifndef scalarType
-typedef dealii::VectorizedArray<double> scalarType;
+typedef dealii::VectorizedArray<numberType> scalarType;
 #endif
 #ifndef vectorType
 typedef dealii::parallel::distributed::Vector<double> vectorType;
 #endif
+#ifndef floatVectorType
+typedef dealii::parallel::distributed::Vector<float> floatVectorType;
+#endif
 //define FE system types
 #ifndef typeScalar
-typedef dealii::FEEvaluation<problemDIM,finiteElementDegree,finiteElementDegree+1,1,double>           typeScalar;
+typedef dealii::FEEvaluation<problemDIM,finiteElementDegree,finiteElementDegree+1,1,numberType>       typeScalar;
 #endif
 #ifndef typeVector
-typedef dealii::FEEvaluation<problemDIM,finiteElementDegree,finiteElementDegree+1,problemDIM,double>  typeVector;
+typedef dealii::FEEvaluation<problemDIM,finiteElementDegree,finiteElementDegree+1,problemDIM,numberType>  typeVector;
 #endif
 //define data value types
 #ifndef scalarvalueType
-typedef dealii::VectorizedArray<double> scalarvalueType;
+typedef scalarType scalarvalueType;
 #endif
 #ifndef vectorvalueType
-typedef dealii::Tensor<1, problemDIM, dealii::VectorizedArray<double> > vectorvalueType;
+typedef dealii::Tensor<1, problemDIM, scalarType> vectorvalueType;
 #endif
 #if problemDIM==1
 #ifndef scalargradType
-typedef dealii::VectorizedArray<double> scalargradType;
+typedef scalarType scalargradType;
 #endif
 #ifndef vectorgradType
-typedef dealii::VectorizedArray<double> vectorgradType;
+typedef scalarType vectorgradType;
 #endif
 #ifndef vectorhessType
-typedef dealii::VectorizedArray<double> vectorhessType;
+typedef scalarType vectorhessType;
 #endif
 #else
 #ifndef scalargradType
-typedef dealii::Tensor<1, problemDIM, dealii::VectorizedArray<double> > scalargradType;
+typedef dealii::Tensor<1, problemDIM, scalarType> scalargradType;
 #endif
 #ifndef scalarhessType
-typedef dealii::Tensor<2,problemDIM,dealii::VectorizedArray<double> > scalarhessType;
+typedef dealii::Tensor<2,problemDIM,scalarType> scalarhessType;
 #endif
 #ifndef vectorgradType
-typedef dealii::Tensor<2, problemDIM, dealii::VectorizedArray<double> > vectorgradType;
+typedef dealii::Tensor<2, problemDIM, scalarType> vectorgradType;
 #endif
 #ifndef vectorhessType
-typedef dealii::Tensor<3, problemDIM, dealii::VectorizedArray<double> > vectorhessType;
+typedef dealii::Tensor<3, problemDIM, scalarType> vectorhessType;
 #endif
 #endif
 
 #include "model_variables.h"
 
 //macro for constants
-#define constV(a) make_vectorized_array(a)
+#define constV(a) make_vectorized_array<numberType>(a)
 //macro for defining subdomain specific functions
 #define subdomain(geometricExpression, functionExpression)  ( (geometricExpression) ? (functionExpression) : constV(0.0))
+//exp, log, pow, tanh and atan2 evaluated on all the lanes of a vectorized array at once (vectorizedMath::exp(x), etc.)
+#include "vectorizedMath.h"
 
 //
 using namespace dealii;
 //
+//multigrid preconditioner of an elliptic field, defined in multigrid.cc
+template <int dim> class mgPreconditioner;
+//
+//vectors of the defect correction loop of the mixed precision implicit solves of a field: the double precision defect, the
+//single precision defect and correction of the inner solves, and the temporary copy of the src vector in the single precision vmult()
+struct mixedPrecisionScratch
+{
+  vectorType defect;
+  floatVectorType defectSinglePrecision, correctionSinglePrecision, vmultSrc;
+};
+//
 //base class for matrix free PDE's
 //
 /**
@@ -115,6 +140,32 @@ class MatrixFreePDE:public Subscriptor
    * equations AX=b.
    */
   void vmult (vectorType &dst, const vectorType &src) const;
+  /**
+   * Single precision counterpart of vmult(), used by the inner solves of the mixed precision implicit solves
+   * (see mixedPrecisionEllipticSolves).
+   */
+  void vmult (floatVectorType &dst, const floatVectorType &src) const;
+  /**
+   * Level counterparts of vmult() used by the geometric multigrid preconditioner. vmultLevel() applies the LHS operator
+   * on the given level of the mesh hierarchy, with the Dirichlet and refinement edge degrees of freedom treated as
+   * identity rows. vmultLevelInterface() applies the coupling between the refinement edge and the remaining degrees of
+   * freedom of the level (or its transpose), as needed for the edge matrices of locally refined meshes.
+   */
+  void vmultLevel (const unsigned int level, vectorType &dst, const vectorType &src) const;
+  void vmultLevelInterface (const unsigned int level, vectorType &dst, const vectorType &src, const bool transpose) const;
+  /**
+   * Returns the number of degrees of freedom of the field currently being solved on the given level, and initializes
+   * a vector with the parallel layout of that field on the given level.
+   */
+  types::global_dof_index levelSize (const unsigned int level) const;
+  /**
+   * Matrix size and entry access for the field currently being solved, as expected by the deal.II preconditioners.
+   * The diagonal is passed to the preconditioners explicitly, so el() is not implemented.
+   */
+  types::global_dof_index m () const;
+  types::global_dof_index n () const;
+  double el (const types::global_dof_index i, const types::global_dof_index j) const;
+  void initializeLevelVector (const unsigned int level, vectorType &vec) const;
   /**
    * Vector of all the physical fields in the problem. Fields are identified by dimentionality (SCALAR/VECTOR),  
    * the kind of PDE (ELLIPTIC/PARABOLIC) used to compute them and a character identifier  (e.g.: "c" for composition)
@@ -183,7 +234,7 @@ class MatrixFreePDE:public Subscriptor
    /*Object of class MatrixFree<dim>. This is primarily responsible for all the base matrix free functionality of this MatrixFreePDE<dim> class.
    *Refer to deal.ii documentation of MatrixFree<dim> class for details.
    */
-  MatrixFree<dim,double>               matrixFreeObject;
+  MatrixFree<dim,numberType>               matrixFreeObject;
   /*Vector to store the inverse of the mass matrix diagonal. Due to the choice of spectral elements with Guass-Lobatto quadrature, the mass matrix is diagonal.*/
   vectorType                           invM;
   /*Vector to store the solution increment. This is a temporary vector used during implicit solves of the Elliptic fields.*/
@@ -198,29 +249,167 @@ class MatrixFreePDE:public Subscriptor
   void computeInvM();
   /*Method to compute the right hand side (RHS) residual vectors*/  
   void computeRHS();
+  /*Local sum of (u-u) over the solution values updated since the last NaN check, which is finite unless a value is NaN or Inf.*/
+  double solutionCheck;
+  /*Method to do the explicit update (solution=invM*residual) of a set of parabolic fields at once, using threads and SIMD instructions.
+   *Returns a local value that is not finite if any of the updated values is not finite.*/
+  double updateExplicitFields(const std::vector<unsigned int> &fieldIndices);
+  /*Kernel of updateExplicitFields() for the local DOF range [begin,end) of invM. Returns a value that is not finite if any of the updated values is not finite.*/
+  double updateExplicitFieldsRange(const std::vector<unsigned int> &fieldIndices, const unsigned int begin, const unsigned int end) const;
+  /*Method implementing the time stepping loop with adaptive time steps (embedded Runge-Kutta pair with a PI step size controller), used when adaptiveTimeStepping is true.*/
+  void solveAdaptiveTimeSteps(int &currentOutput);
+  /*Method to compute the time derivatives of the time integrated fields at the current solution vectors, stored as the given Runge-Kutta stage.*/
+  void computeTimeDerivatives(const unsigned int stage, const double baseTimeStep);
+  /*Method to set the solution vectors to the Runge-Kutta stage y0+h*sum_j(coefficients[j]*k_j).*/
+  void setTimeStepStage(const double h, const std::vector<double> &coefficients);
+  /*Solution at the start of the time step followed by the Runge-Kutta stages k_j for each field. Cleared in reinit().*/
+  std::vector<std::vector<vectorType> > rkVectorSet;
+  /*Flags for the fields listed in imexFields and their coupled fields, and the index of the coupled field of each IMEX field (-1 if none).*/
+  std::vector<bool> isIMEXField, isIMEXCoupledField;
+  std::vector<int> imexCoupledFieldSet;
+  /*Temporary vector for the coupled field in vmultIMEX() and the increment of the last IMEX solve (used as the next initial guess) for each IMEX field.*/
+  mutable std::vector<vectorType> imexScratchSet;
+  std::vector<vectorType> imexIncrementSet;
+  /*Method to parse imexFields and allocate the vectors of the IMEX solves, called in init() and reinit().*/
+  void setupIMEXFields();
+  /*Method to apply the IMEX operator (M + timeStep*L) of the field given by currentFieldIndex, used by vmult().*/
+  void vmultIMEX (vectorType &dst, const vectorType &src) const;
+  /*Method to do the IMEX update of a field from its residual.*/
+  void solveIMEXIncrement(unsigned int fieldIndex);
+  /*Fields listed in auxiliaryFields, which are recomputed from the other fields at each Runge-Kutta stage instead of being integrated in time.*/
+  std::vector<bool> isAuxiliaryField;
+  /*Flag for each cell batch of the matrix free object that getRHS evaluates when activeRegionSkipping is true. Empty when all the
+   *cell batches are evaluated, cleared in reinit().*/
+  std::vector<bool> activeCellBatchSet;
+  /*Positive at the DOFs of each field that belong to an interface cell (the active region), zero elsewhere.*/
+  std::vector<vectorType> activeRegionIndicatorSet;
+  /*Method to classify the cells as interface or bulk cells from activeRegionFields and find the cell batches evaluated until the next classification.*/
+  void updateActiveRegion();
+  /*Method to set the residuals of the DOFs outside the active region to those of a stationary solution.*/
+  void freezeInactiveRegion();
+  /*Returns whether getRHS evaluates the given cell batch.*/
+  bool isActiveCellBatch(const unsigned int cell) const;
+  /*Method to find the grains of the grainRemappingFields (distributed flood fill) and move the grains that are too close to a grain of
+   *the same field to another field, used when grainRemapping is true.*/
+  void remapGrains();
 
   /*AMR methods*/
-  void refineGrid();
+  /*Method to refine and coarsen the flagged cells, returns false without changing the mesh if no cell is flagged on any process.*/
+  bool refineGrid();
   /*Virtual method to mark the regions to be adpatively refined. This is expected to be provided by the user.*/
   virtual void adaptiveRefine(unsigned int _currentIncrement);
   /*Virtual method to define AMR refinement criterion. The default implementation uses the Kelly error estimate for estimative the error function. The user can supply a custom implementation to overload the default implementation.*/
   virtual void adaptiveRefineCriterion();
+  /*Flag for each active cell (by active_cell_index) of the locally owned cells flagged for refinement by the refinement criterion, which are
+   *the interface cells of the cost model of the weighted repartitioning.*/
+  std::vector<bool> interfaceCellSet;
+  /*Method to fill interfaceCellSet from the refine flags set by adaptiveRefineCriterion().*/
+  void markInterfaceCells();
+  /*Modeled cost of an active cell relative to a bulk cell without hanging nodes (interfaceCellWeight and hangingNodeCellWeight).*/
+  double cellCost(const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell) const;
+  /*Weight of a cell for the weighted repartitioning, connected to the cell_weight signal of the triangulation when weightedRepartitioning is true.*/
+  unsigned int cellWeight(const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+			  const typename parallel::distributed::Triangulation<dim>::CellStatus status) const;
+  /*Number of consecutive checks of isRemeshingRequired() that did not require a remesh.*/
+  unsigned int skippedRemeshings;
+  /*Whether the refine and coarsen flags of the next refineGrid() were already set by isRemeshingRequired().*/
+  bool refineFlagsSet;
+  /*Method to check whether an interface has moved out of the refined zone, used to skip unneeded remeshings when adaptiveRemeshing is true.*/
+  bool isRemeshingRequired();
+  /*Method to print the largest number of cells (and with weightedRepartitioning the modeled cost) of a process relative to the average, called after each remesh.*/
+  void printLoadBalance();
   
   //virtual methods to be implemented in the derived class
   /*Method to calculate LHS(implicit solve)*/
-  virtual void getLHS(const MatrixFree<dim,double> &data, 
+  virtual void getLHS(const MatrixFree<dim,numberType> &data, 
 		      vectorType &dst, 
 		      const vectorType &src,
 		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  /*Method to calculate a block of the LHS operator: the LHS of the residual equation of the field fieldIndex with respect to the change of
+   *the field srcFieldIndex, given by src. getLHS is the diagonal block of currentFieldIndex. Used by the coupled IMEX operator.*/
+  virtual void getLHSBlock(const MatrixFree<dim,numberType> &data,
+		      vectorType &dst,
+		      const vectorType &src,
+		      const std::pair<unsigned int,unsigned int> &cell_range,
+		      const unsigned int fieldIndex,
+		      const unsigned int srcFieldIndex) const;
+  /*Method to calculate LHS on single precision vectors, used by the inner solves of mixedPrecisionEllipticSolves*/
+  virtual void getLHSSinglePrecision(const MatrixFree<dim,numberType> &data,
+		      floatVectorType &dst,
+		      const floatVectorType &src,
+		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  /*Virtual method to discard any objects that refer to the matrix free objects (such as reusable FEEvaluation objects), called at the start of reinit().*/
+  virtual void clearEvaluatorPools();
+  /*Virtual methods to cache the fields that are not solved for at the quadrature points before the implicit solve of a field (these
+   *fields do not change during the solve, so getLHS then only has to evaluate src), and to discard the cache after the solve.
+   *The default implementations do nothing.*/
+  virtual void cacheLHSFields(unsigned int fieldIndex);
+  virtual void clearLHSFieldCache();
+  /*Method to calculate the diagonal of the LHS operator, used to build the smoothers and preconditioners of the implicit solves.*/
+  virtual void getLHSDiagonal(const MatrixFree<dim,numberType> &data,
+		      vectorType &dst,
+		      const vectorType &src,
+		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  /*Inverse of the diagonal of the LHS operator for each elliptic field (NULL for the other fields), used by the JACOBI and CHEBYSHEV
+   *preconditioners. It is computed in init() and reinit() and reused by all the implicit solves on the same mesh.*/
+  std::vector<DiagonalMatrix<vectorType>*> diagonalInverseSet;
+  /*Chebyshev-accelerated Jacobi preconditioner of each elliptic field (NULL for the other fields) for the CHEBYSHEV preconditioner. It is
+   *rebuilt with diagonalInverseSet, so its eigenvalue estimate is done on the first solve after init() or reinit() and then reused.*/
+  std::vector<PreconditionChebyshev<MatrixFreePDE<dim>, vectorType>*> chebyshevPreconditionerSet;
+  /*Single precision copies of diagonalInverseSet and chebyshevPreconditionerSet, used by the inner solves of the mixed precision
+   *implicit solves (if mixedPrecisionEllipticSolves is true) and rebuilt with them.*/
+  std::vector<DiagonalMatrix<floatVectorType>*> diagonalInverseSinglePrecisionSet;
+  std::vector<PreconditionChebyshev<MatrixFreePDE<dim>, floatVectorType>*> chebyshevPreconditionerSinglePrecisionSet;
+  /*Method to compute diagonalInverseSet and chebyshevPreconditionerSet, and their single precision copies.*/
+  void computeLHSDiagonal();
+  /*Returns the set of solution vectors that getLHS should read the non-solved fields from. This is solutionSet for the
+   *active mesh and the level copies of the solution vectors when data is one of the multigrid level matrix free objects.*/
+  const std::vector<vectorType*> & getLHSFieldSet(const MatrixFree<dim,numberType> &data) const;
+  /*Previous increments of each elliptic field (most recent first), used for the extrapolated initial guesses of the implicit solves.*/
+  std::vector<std::vector<vectorType> > dUHistorySet;
+  /*A-orthonormal basis of the subspace spanned by the previous increments of each elliptic field, and the LHS operator applied to it,
+   *used for the projected initial guess of the implicit solves.*/
+  std::vector<std::vector<vectorType> > recycledBasisSet, recycledBasisLHSSet;
+  /*Method to set the initial guess for the increment dU of the current field given the residual R, as set by implicitInitialGuess.*/
+  void getImplicitInitialGuess(unsigned int fieldIndex, vectorType &dU, const vectorType &R);
+  /*Method to store the converged increment dU of the current field for the initial guesses of the following implicit solves.*/
+  void storeImplicitIncrement(unsigned int fieldIndex, const vectorType &dU);
+  /*Method to discard the stored increments of a field, after an implicit solve that did not converge.*/
+  void resetImplicitIncrements(unsigned int fieldIndex);
+  /*Number of consecutive skipped implicit solves, reference (largest initial) residual norm and whether the reference has been taken
+   *(it can be zero) for each elliptic field, used by adaptiveSkipImplicitSolves.*/
+  std::vector<unsigned int> skippedImplicitSolvesSet;
+  std::vector<double> referenceResidualSet;
+  std::vector<bool> referenceResidualTakenSet;
+  /*Method to decide whether the implicit solve of an elliptic field is done in the current increment.*/
+  bool isImplicitSolveRequired(unsigned int fieldIndex);
+  /*Method to solve the linear system for the increment dU of the current field with the selected preconditioner.*/
+  template <typename SolverType>
+  void solveLinearSystem(SolverType &solver, vectorType &dU, const vectorType &R);
+  /*Method to solve the linear system for the increment dU of the current field by defect correction, with the residual computed in
+   *double precision and the corrections by single precision inner solves (used if mixedPrecisionEllipticSolves is true).*/
+  void solveLinearSystemMixedPrecision(SolverControl &solver_control, vectorType &dU, const vectorType &R);
   /*Method to calculate RHS (implicit/explicit). This is an abstract method, so every model which inherits MatrixFreePDE<dim> has to implement this method.*/
-  virtual void getRHS (const MatrixFree<dim,double> &data, 
+  virtual void getRHS (const MatrixFree<dim,numberType> &data, 
 		       std::vector<vectorType*> &dst, 
 		       const std::vector<vectorType*> &src,
 		       const std::pair<unsigned int,unsigned int> &cell_range) const = 0;
   
   //methods to apply dirichlet BC's
-  /*Map of degrees of freedom to the corresponding Dirichlet boundary conditions, is any.*/
-  std::vector<std::map<dealii::types::global_dof_index, double>*> valuesDirichletSet;
+  /*Locally owned degrees of freedom with Dirichlet boundary conditions for each field, stored as sorted local indices (as used by
+   *local_element()) together with the corresponding Dirichlet values. Built in init() and reinit() and used in vmult() and solveIncrement().*/
+  std::vector<std::vector<unsigned int> > dirichletLocalIndicesSet;
+  std::vector<std::vector<double> > dirichletLocalValuesSet;
+  /*Method to fill dirichletLocalIndicesSet and dirichletLocalValuesSet for a field from its Dirichlet constraints, visiting only the locally owned degrees of freedom.*/
+  void storeDirichletDOFs(const unsigned int fieldIndex);
+  /*Temporary copy of the src vector in vmult() for each elliptic field, allocated in init() and reinit().*/
+  mutable std::vector<vectorType> vmultScratchSet;
+  /*Vectors of the mixed precision implicit solves for each elliptic field, allocated in init() and reinit() if mixedPrecisionEllipticSolves is true.*/
+  mutable std::vector<mixedPrecisionScratch> mixedPrecisionScratchSet;
+  /*Method to allocate the vectors of mixedPrecisionScratchSet for a field.*/
+  void initializeMixedPrecisionScratch(const unsigned int fieldIndex);
+  /*Virtual method to get the level degrees of freedom (one index set per level) with Dirichlet boundary conditions for the field given by currentFieldIndex.*/
+  virtual void getLevelDirichletIndices(std::vector<IndexSet> &);
   /*Virtual method to mark the boundaries for applying Dirichlet boundary conditions.  This is usually expected to be provided by the user.*/  
   virtual void markBoundaries();
   /*Virtual method for applying Dirichlet boundary conditions.  This is usually expected to be provided by the user.*/ 
@@ -237,9 +426,41 @@ class MatrixFreePDE:public Subscriptor
   virtual void applyInitialConditions();
   virtual void modifySolutionFields ();
 
+  //geometric multigrid methods
+  /*Flag used to mark problems where the implicit solves are preconditioned by geometric multigrid.*/
+  bool isMultigridPreconditioned;
+  /*Level matrix free objects, one per level of the mesh hierarchy, holding the level DOFs of all the fields.*/
+  std::vector<MatrixFree<dim,numberType>*> mgMatrixFreeSet;
+  /*Level copies of the solution vectors (indexed by level, then by field). They provide the non-solved fields to getLHS on each level.*/
+  std::vector<std::vector<vectorType*> > mgSolutionSet;
+  /*Locally owned level DOFs (as local indices, indexed by field, then by level) with Dirichlet BCs and on refinement edges.*/
+  std::vector<std::vector<std::vector<unsigned int> > > mgDirichletIndicesSet, mgEdgeIndicesSet;
+  /*Level constraints (refinement edges) for each elliptic field.*/
+  std::vector<MGConstrainedDoFs*> mgConstrainedDoFsSet;
+#if DEAL_II_VERSION_GTE(8,5,0)
+  /*Transfer operators between the active mesh and the levels for each elliptic field.*/
+  std::vector<MGTransferMatrixFree<dim,double>*> mgTransferSet;
+#endif
+  /*Inverse of the diagonal of the LHS operator on each level (indexed by field, then by level), used by the Chebyshev smoothers.*/
+  std::vector<std::vector<vectorType> > mgDiagonalInverseSet;
+  /*Temporary vectors for the level operators (indexed by field, then by level), with the ghost layout of the level matrix free objects.*/
+  mutable std::vector<std::vector<vectorType> > mgSrcScratchSet, mgDstScratchSet;
+#if DEAL_II_VERSION_GTE(8,5,0)
+  /*Multigrid preconditioner of each elliptic field (NULL for the other fields). Like chebyshevPreconditionerSet, it is built in init() and
+   *reinit() from the fields at that time, and its smoother eigenvalue estimates are done on the first solve and then reused.*/
+  std::vector<mgPreconditioner<dim>*> mgPreconditionerSet;
+#endif
+  /*Method to setup the level DOFs, level matrix free objects and transfer operators. Called in init() and reinit().*/
+  void setupMultigrid();
+  /*Method to update the level copies of the solution vectors (the coefficients of the level operators) and the level diagonals, and to
+   *rebuild mgPreconditionerSet. Called in init() and reinit() after the solution vectors are set.*/
+  void updateMultigrid();
+  /*Method to delete the level data structures.*/
+  void clearMultigrid();
+
   /*Method to compute energy like quantities.*/
   void computeEnergy();
-  virtual void getEnergy(const MatrixFree<dim,double> &data,
+  virtual void getEnergy(const MatrixFree<dim,numberType> &data,
 		    std::vector<vectorType*> &dst,
 		    const std::vector<vectorType*> &src,
 		    const std::pair<unsigned int,unsigned int> &cell_range);
@@ -290,6 +511,13 @@ class MatrixFreePDE:public Subscriptor
 #include "../src/matrixfree/modifyFields.cc"
 #include "../src/matrixfree/solve.cc"
 #include "../src/matrixfree/solveIncrement.cc"
+#include "../src/matrixfree/adaptiveTimeStepping.cc"
+#include "../src/matrixfree/imex.cc"
+#include "../src/matrixfree/activeRegion.cc"
+#include "../src/matrixfree/grainRemapping.cc"
+#include "../src/matrixfree/multigrid.cc"
+#include "../src/matrixfree/solveLinearSystem.cc"
+#include "../src/matrixfree/implicitInitialGuess.cc"
 #include "../src/matrixfree/outputResults.cc"
 #include "../src/matrixfree/markBoundaries.cc"
 #include "../src/matrixfree/boundaryConditions.cc"
@@ -1,24 +1,74 @@
 // Model Variables Class
 
+// The value and derivatives of a variable at a quadrature point. They are stored compactly in the storage of the variable
+// list set up by setupModelVariables(): only the entries requested in equations.h are allocated, at the positions given by
+// the offset table of the variable. The entries are read (and written) through the accessors, e.g. scalarValue(). The entries
+// that are not requested all point to a block of zeros at the end of the storage (at zero_offset), which may only be read.
 template<int dim>
 class modelVariable
 {
  public:
 	modelVariable();
-	scalarvalueType scalarValue;
-	scalargradType scalarGrad;
-	scalarhessType scalarHess;
 
-	vectorvalueType vectorValue;
-	vectorgradType vectorGrad;
-	vectorhessType vectorHess;
+	enum entryType {scalar_value, scalar_grad, scalar_hess, vector_value, vector_grad, vector_hess, n_entry_types};
+
+	// Set the storage of the variable list, the offsets of the entries of this variable in it and the offset of the block of zeros
+	void setStorage(scalarType *_storage, const int *_offsets, const int _zero_offset);
+
+	scalarvalueType & scalarValue() {return entry<scalarvalueType>(scalar_value);}
+	scalargradType & scalarGrad() {return entry<scalargradType>(scalar_grad);}
+	scalarhessType & scalarHess() {return entry<scalarhessType>(scalar_hess);}
+	vectorvalueType & vectorValue() {return entry<vectorvalueType>(vector_value);}
+	vectorgradType & vectorGrad() {return entry<vectorgradType>(vector_grad);}
+	vectorhessType & vectorHess() {return entry<vectorhessType>(vector_hess);}
+
+	const scalarvalueType & scalarValue() const {return entry<scalarvalueType>(scalar_value);}
+	const scalargradType & scalarGrad() const {return entry<scalargradType>(scalar_grad);}
+	const scalarhessType & scalarHess() const {return entry<scalarhessType>(scalar_hess);}
+	const vectorvalueType & vectorValue() const {return entry<vectorvalueType>(vector_value);}
+	const vectorgradType & vectorGrad() const {return entry<vectorgradType>(vector_grad);}
+	const vectorhessType & vectorHess() const {return entry<vectorhessType>(vector_hess);}
+
+	// Whether the variable is evaluated on the current cell batch. A variable flagged in sparse_var (equations.h) is inactive
+	// on the cell batches where it vanishes: it then reads as zero and its residual is not used, so residualRHS can skip it.
+	bool isActive() const {return active;}
+	void setActive(const bool _active) {active = _active;}
+
+ private:
+	template <typename T>
+	T & entry(const entryType type) {
+		Assert(offsets[type] != zero_offset, dealii::ExcMessage("Writable access to a value or derivative that is not requested in equations.h"));
+		return *reinterpret_cast<T *>(storage + offsets[type]);
+	}
+
+	template <typename T>
+	const T & entry(const entryType type) const {
+		return *reinterpret_cast<const T *>(storage + offsets[type]);
+	}
+
+	scalarType *storage;
+	int offsets[n_entry_types];
+	int zero_offset;
+	bool active;
 };
 
 //constructor
 template<int dim>
-modelVariable<dim>::modelVariable()
+modelVariable<dim>::modelVariable(): storage(NULL), zero_offset(-1), active(true)
 {
+	for (unsigned int i=0; i<n_entry_types; i++){
+		offsets[i] = -1;
+	}
+}
 
+template<int dim>
+void modelVariable<dim>::setStorage(scalarType *_storage, const int *_offsets, const int _zero_offset)
+{
+	storage = _storage;
+	zero_offset = _zero_offset;
+	for (unsigned int i=0; i<n_entry_types; i++){
+		offsets[i] = _offsets[i];
+	}
 }
 
 template<int dim>
@@ -32,11 +82,17 @@ class modelResidual
 	vectorvalueType vectorValueResidual;
 	vectorgradType vectorGradResidual;
 
+	// Set for residualLHS: the field whose residual equation is computed and the field whose change is given in the variable
+	// list (the field being solved for). They differ only in the blocks of the coupled IMEX operator, e.g. for imexFields "c:mu"
+	// the LHS of the mu equation with respect to the change in c and the LHS of the c equation with respect to the change in mu.
+	unsigned int fieldIndex;
+	unsigned int changedFieldIndex;
+
 };
 
 //constructor
 template<int dim>
-modelResidual<dim>::modelResidual()
+modelResidual<dim>::modelResidual(): fieldIndex(0), changedFieldIndex(0)
 {
 
 }
@@ -49,9 +105,40 @@ struct variable_info
 	unsigned int global_var_index;
 };
 
-
-
-
-
-
-
+// Allocate the compact storage of a list of variables and set the offset table of each variable. The flags are indexed
+// by the global variable index.
+template<int dim>
+void setupModelVariables(const std::vector<variable_info<dim> > &varInfoList, const std::vector<bool> &need_value,
+		const std::vector<bool> &need_gradient, const std::vector<bool> &need_hessian,
+		std::vector<modelVariable<dim> > &modelVarList, dealii::AlignedVector<scalarType> &storage)
+{
+	const unsigned int entry_size = sizeof(scalarType);
+	std::vector<int> offsets(varInfoList.size()*modelVariable<dim>::n_entry_types, -1);
+	int n_entries = 0;
+	for (unsigned int i=0; i<varInfoList.size(); i++){
+		const unsigned int var = varInfoList[i].global_var_index;
+		int *var_offsets = &offsets[i*modelVariable<dim>::n_entry_types];
+		if (varInfoList[i].is_scalar){
+			if (need_value[var]) {var_offsets[modelVariable<dim>::scalar_value] = n_entries; n_entries += sizeof(scalarvalueType)/entry_size;}
+			if (need_gradient[var]) {var_offsets[modelVariable<dim>::scalar_grad] = n_entries; n_entries += sizeof(scalargradType)/entry_size;}
+			if (need_hessian[var]) {var_offsets[modelVariable<dim>::scalar_hess] = n_entries; n_entries += sizeof(scalarhessType)/entry_size;}
+		}
+		else {
+			if (need_value[var]) {var_offsets[modelVariable<dim>::vector_value] = n_entries; n_entries += sizeof(vectorvalueType)/entry_size;}
+			if (need_gradient[var]) {var_offsets[modelVariable<dim>::vector_grad] = n_entries; n_entries += sizeof(vectorgradType)/entry_size;}
+			if (need_hessian[var]) {var_offsets[modelVariable<dim>::vector_hess] = n_entries; n_entries += sizeof(vectorhessType)/entry_size;}
+		}
+	}
+
+	// Block of zeros for the entries that are not requested
+	const int zero_offset = n_entries;
+	for (unsigned int i=0; i<offsets.size(); i++){
+		if (offsets[i] < 0) offsets[i] = zero_offset;
+	}
+	storage.resize(zero_offset + sizeof(vectorhessType)/entry_size);
+	storage.fill(dealii::make_vectorized_array<numberType>(0.0));
+	modelVarList.resize(varInfoList.size());
+	for (unsigned int i=0; i<varInfoList.size(); i++){
+		modelVarList[i].setStorage(storage.begin(), &offsets[i*modelVariable<dim>::n_entry_types], zero_offset);
+	}
+}
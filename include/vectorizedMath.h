@@ -0,0 +1,207 @@
+//exp, log, pow, tanh and atan2 for vectorized arrays
+#ifndef VECTORIZEDMATH_H
+#define VECTORIZEDMATH_H
+
+//The std:: versions of these functions for VectorizedArray call the scalar function once per lane. These versions reduce the
+//argument lane by lane (integer and bit operations only) and evaluate the polynomial or rational approximation on all the lanes at
+//once. For double precision the relative error is a few units in the last place (pow: |y*log(x)| times that), see
+//tests/unit_tests/test_vectorizedMath.h. Lanes with arguments outside the domain of the approximation (NaN, Inf, non-positive
+//arguments of log and pow) fall back to the scalar function.
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace vectorizedMath{
+
+//2^k for the exponents of normal double precision numbers, built from the bits of the exponent
+inline double pow2(const int k){
+	if ((k < -1022) || (k > 1023)) return std::ldexp(1.0,k);
+	const unsigned long long bits = ((unsigned long long) (k+1023)) << 52;
+	double result;
+	std::memcpy(&result, &bits, sizeof(double));
+	return result;
+}
+
+//Taylor polynomial of exp(r)-1 (r times a polynomial in r), accurate for |r| <= ln(2)/2
+template <typename Number>
+inline dealii::VectorizedArray<Number> expm1Taylor(const dealii::VectorizedArray<Number> &r){
+	dealii::VectorizedArray<Number> p = dealii::make_vectorized_array<Number>(1.0/6227020800.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/479001600.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/39916800.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/3628800.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/362880.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/40320.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/5040.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/720.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/120.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/24.0);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0/6.0);
+	p = p*r + dealii::make_vectorized_array<Number>(0.5);
+	p = p*r + dealii::make_vectorized_array<Number>(1.0);
+	return p*r;
+}
+
+//exp(x) = 2^k exp(r), with k the nearest integer to x/ln(2) and |r| <= ln(2)/2
+template <typename Number>
+inline dealii::VectorizedArray<Number> exp(const dealii::VectorizedArray<Number> &x){
+	const double log2e = 1.44269504088896338700e+00;
+	const double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+	dealii::VectorizedArray<Number> xr = x, k, scale;
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		const double xi = x[i];
+		double ki = 0.0;
+		scale[i] = 1.0;
+		if (xi > 709.0){
+			scale[i] = std::numeric_limits<Number>::infinity();
+			xr[i] = 0.0;
+		}
+		else if (xi < -708.0){
+			scale[i] = 0.0;
+			xr[i] = 0.0;
+		}
+		else if (xi == xi){
+			ki = std::floor(xi*log2e+0.5);
+			scale[i] = pow2((int) ki);
+		}
+		k[i] = ki;
+	}
+	const dealii::VectorizedArray<Number> r = (xr - k*dealii::make_vectorized_array<Number>(ln2_hi)) - k*dealii::make_vectorized_array<Number>(ln2_lo);
+	return (expm1Taylor(r) + dealii::make_vectorized_array<Number>(1.0))*scale;
+}
+
+//log(x) = e ln(2) + log(m), with x = m 2^e and sqrt(1/2) <= m < sqrt(2), and log(m) = 2 atanh((m-1)/(m+1)) from its series
+template <typename Number>
+inline dealii::VectorizedArray<Number> log(const dealii::VectorizedArray<Number> &x){
+	const double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+	dealii::VectorizedArray<Number> m, e;
+	bool special[dealii::VectorizedArray<Number>::n_array_elements];
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		const double xi = x[i];
+		// Exponent and mantissa from the bits of normal positive numbers, the other lanes use the scalar function
+		special[i] = !((xi >= std::numeric_limits<double>::min()) && (xi <= std::numeric_limits<double>::max()));
+		int ei = 0;
+		double mi = 1.0;
+		if (!special[i]){
+			unsigned long long bits;
+			std::memcpy(&bits, &xi, sizeof(double));
+			ei = (int) (bits >> 52) - 1023;
+			bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+			std::memcpy(&mi, &bits, sizeof(double));
+			if (mi > 1.41421356237309504880){
+				mi *= 0.5;
+				ei++;
+			}
+		}
+		m[i] = mi;
+		e[i] = ei;
+	}
+	const dealii::VectorizedArray<Number> one = dealii::make_vectorized_array<Number>(1.0);
+	const dealii::VectorizedArray<Number> s = (m-one)/(m+one);
+	const dealii::VectorizedArray<Number> z = s*s;
+	dealii::VectorizedArray<Number> p = dealii::make_vectorized_array<Number>(1.0/21.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/19.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/17.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/15.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/13.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/11.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/9.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/7.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/5.0);
+	p = p*z + dealii::make_vectorized_array<Number>(1.0/3.0);
+	dealii::VectorizedArray<Number> result = e*dealii::make_vectorized_array<Number>(ln2_hi)
+			+ (dealii::make_vectorized_array<Number>(2.0)*(s + s*z*p) + e*dealii::make_vectorized_array<Number>(ln2_lo));
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		if (special[i]) result[i] = std::log(x[i]);
+	}
+	return result;
+}
+
+//pow(x,y) = exp(y log(x)) for positive x
+template <typename Number>
+inline dealii::VectorizedArray<Number> pow(const dealii::VectorizedArray<Number> &x, const dealii::VectorizedArray<Number> &y){
+	dealii::VectorizedArray<Number> result = vectorizedMath::exp(y*vectorizedMath::log(x));
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		if (!((x[i] > 0.0) && (x[i] <= std::numeric_limits<Number>::max()) && (std::abs(y[i]) <= std::numeric_limits<Number>::max()))){
+			result[i] = std::pow(x[i], y[i]);
+		}
+	}
+	return result;
+}
+
+template <typename Number>
+inline dealii::VectorizedArray<Number> pow(const dealii::VectorizedArray<Number> &x, const Number y){
+	return vectorizedMath::pow(x, dealii::make_vectorized_array<Number>(y));
+}
+
+//tanh(|x|) = -expm1(-2|x|)/(2+expm1(-2|x|)), with expm1 from its Taylor polynomial for small arguments to avoid cancellation
+template <typename Number>
+inline dealii::VectorizedArray<Number> tanh(const dealii::VectorizedArray<Number> &x){
+	dealii::VectorizedArray<Number> r, sign;
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		sign[i] = (x[i] < 0.0 ? -1.0 : 1.0);
+		r[i] = -2.0*std::abs(x[i]);
+	}
+	dealii::VectorizedArray<Number> em1 = vectorizedMath::exp(r) - dealii::make_vectorized_array<Number>(1.0);
+	const dealii::VectorizedArray<Number> em1Small = expm1Taylor(r);
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		if (r[i] > -0.34657359027997265471) em1[i] = em1Small[i];
+	}
+	return -sign*em1/(dealii::make_vectorized_array<Number>(2.0)+em1);
+}
+
+//atan2(y,x) from the atan of the ratio of the smaller to the larger magnitude (Cephes rational approximation, reduced to |z| <= 0.66)
+template <typename Number>
+inline dealii::VectorizedArray<Number> atan2(const dealii::VectorizedArray<Number> &y, const dealii::VectorizedArray<Number> &x){
+	const double pi = 3.14159265358979323846, morebits = 6.123233995736765886130e-17;
+	dealii::VectorizedArray<Number> z, offset, correction;
+	bool reduced[dealii::VectorizedArray<Number>::n_array_elements];
+	dealii::VectorizedArray<Number> num, den;
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		const double ax = std::abs(x[i]), ay = std::abs(y[i]);
+		num[i] = std::min(ax, ay);
+		den[i] = (std::max(ax, ay) > 0.0 ? std::max(ax, ay) : 1.0);
+	}
+	z = num/den;
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		reduced[i] = (z[i] > 0.66);
+		offset[i] = (reduced[i] ? 0.25*pi : 0.0);
+		correction[i] = (reduced[i] ? 0.5*morebits : 0.0);
+	}
+	const dealii::VectorizedArray<Number> one = dealii::make_vectorized_array<Number>(1.0);
+	const dealii::VectorizedArray<Number> zReduced = (z-one)/(z+one);
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		if (reduced[i]) z[i] = zReduced[i];
+	}
+	const dealii::VectorizedArray<Number> w = z*z;
+	dealii::VectorizedArray<Number> P = dealii::make_vectorized_array<Number>(-8.750608600031904122785e-1);
+	P = P*w + dealii::make_vectorized_array<Number>(-1.615753718733365076637e1);
+	P = P*w + dealii::make_vectorized_array<Number>(-7.500855792314704667340e1);
+	P = P*w + dealii::make_vectorized_array<Number>(-1.228866684490136173410e2);
+	P = P*w + dealii::make_vectorized_array<Number>(-6.485021904942025371773e1);
+	dealii::VectorizedArray<Number> Q = w + dealii::make_vectorized_array<Number>(2.485846490142306297962e1);
+	Q = Q*w + dealii::make_vectorized_array<Number>(1.650270098316988542046e2);
+	Q = Q*w + dealii::make_vectorized_array<Number>(4.328810604912902668951e2);
+	Q = Q*w + dealii::make_vectorized_array<Number>(4.853903996359136964868e2);
+	Q = Q*w + dealii::make_vectorized_array<Number>(1.945506571482613964425e2);
+	dealii::VectorizedArray<Number> result = offset + ((z + z*(w*P/Q)) + correction);
+
+	// Quadrant of (x,y)
+	for (unsigned int i=0; i<dealii::VectorizedArray<Number>::n_array_elements; i++){
+		const double xi = x[i], yi = y[i];
+		if (!((std::abs(xi) <= std::numeric_limits<Number>::max()) && (std::abs(yi) <= std::numeric_limits<Number>::max()))){
+			result[i] = std::atan2(yi, xi);
+			continue;
+		}
+		double a = result[i];
+		if (std::abs(yi) > std::abs(xi)) a = 0.5*pi - a;
+		if (std::signbit(xi)) a = pi - a;
+		if (std::signbit(yi)) a = -a;
+		result[i] = a;
+	}
+	return result;
+}
+
+}
+
+#endif
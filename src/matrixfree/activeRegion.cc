@@ -0,0 +1,192 @@
+//active region methods (skipping of the bulk cells in the RHS evaluation) for MatrixFreePDE class
+
+#ifndef ACTIVEREGION_MATRIXFREE_H
+#define ACTIVEREGION_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//With activeRegionSkipping, the cells are classified as interface cells (a value of one of the activeRegionFields is inside the window
+//(activeRegionWindowMin, activeRegionWindowMax), or the values of the cell lie on both sides of the window) or bulk cells. The DOFs of the
+//interface cells and of their neighbors (the cells sharing a DOF with an interface cell) form the active region, so the interface can
+//move into the neighboring cells before the next classification. Between two classifications getRHS only evaluates the cell batches with
+//a DOF of the active region, which gives the complete residual of each active DOF, and the DOFs outside the active region are held fixed.
+
+//set the DOFs of the lanes set in the mask to one in the indicator vector
+template <typename FEEvaluationType>
+void markActiveRegionDOFs(FEEvaluationType &fe_eval, const AlignedVector<scalarType> &mask, vectorType &indicator){
+	for (unsigned int cell=0; cell<mask.size(); ++cell){
+		fe_eval.reinit(cell);
+		for (unsigned int k=0; k<fe_eval.dofs_per_cell; ++k){
+			fe_eval.begin_dof_values()[k] = mask[cell];
+		}
+		fe_eval.distribute_local_to_global(indicator);
+	}
+}
+
+//set the lanes of the cells with a DOF marked in the indicator vector to one in the mask
+template <int dim, typename FEEvaluationType>
+void findMarkedLanes(const MatrixFree<dim,numberType> &data, FEEvaluationType &fe_eval, const vectorType &indicator, AlignedVector<scalarType> &mask){
+	for (unsigned int cell=0; cell<mask.size(); ++cell){
+		fe_eval.reinit(cell);
+		fe_eval.read_dof_values(indicator);
+		for (unsigned int lane=0; lane<data.n_components_filled(cell); lane++){
+			for (unsigned int k=0; k<fe_eval.dofs_per_cell; ++k){
+				if (fe_eval.begin_dof_values()[k][lane] > 0.0){
+					mask[cell][lane] = 1.0;
+					break;
+				}
+			}
+		}
+	}
+}
+
+//flag the cell batches with a DOF in the active region (with the hanging node constraints applied)
+template <typename FEEvaluationType>
+void findActiveCellBatches(FEEvaluationType &fe_eval, const vectorType &indicator, std::vector<bool> &activeCellBatches){
+	for (unsigned int cell=0; cell<activeCellBatches.size(); ++cell){
+		if (activeCellBatches[cell]) continue;
+		fe_eval.reinit(cell);
+		fe_eval.read_dof_values(indicator);
+		for (unsigned int k=0; (k<fe_eval.dofs_per_cell) && !activeCellBatches[cell]; ++k){
+			for (unsigned int lane=0; lane<scalarType::n_array_elements; lane++){
+				if (fe_eval.begin_dof_values()[k][lane] > 0.0){
+					activeCellBatches[cell] = true;
+					break;
+				}
+			}
+		}
+	}
+}
+
+//classify the cells from the current solution and find the active region and the cell batches evaluated until the next classification
+template <int dim>
+void MatrixFreePDE<dim>::updateActiveRegion(){
+	std::vector<int> active_region_fields;
+	std::vector<double> window_min, window_max;
+	{int temp[] = activeRegionFields;
+	vectorLoad(temp, sizeof(temp), active_region_fields);}
+	{double temp[] = activeRegionWindowMin;
+	vectorLoad(temp, sizeof(temp), window_min);}
+	{double temp[] = activeRegionWindowMax;
+	vectorLoad(temp, sizeof(temp), window_max);}
+
+	if ((window_min.size() != active_region_fields.size()) || (window_max.size() != active_region_fields.size())){
+		pcout << "\nError: activeRegionWindowMin and activeRegionWindowMax need one entry for each of the activeRegionFields.\n\n";
+		exit(-1);
+	}
+
+	const unsigned int n_cells = matrixFreeObject.n_macro_cells();
+
+	// Interface lanes of each cell batch (one for an interface cell, zero otherwise)
+	AlignedVector<scalarType> interfaceMask(n_cells);
+	interfaceMask.fill(constV(0.0));
+	for (unsigned int i=0; i<active_region_fields.size(); i++){
+		const unsigned int fieldIndex = active_region_fields[i];
+		if (fields[fieldIndex].type != SCALAR){
+			pcout << "\nError: the activeRegionFields must be SCALAR fields.\n\n";
+			exit(-1);
+		}
+		typeScalar fe_eval(matrixFreeObject, fieldIndex);
+		for (unsigned int cell=0; cell<n_cells; ++cell){
+			fe_eval.reinit(cell);
+			fe_eval.read_dof_values_plain(*solutionSet[fieldIndex]);
+			for (unsigned int lane=0; lane<matrixFreeObject.n_components_filled(cell); lane++){
+				bool below = false, above = false, inside = false;
+				for (unsigned int k=0; k<typeScalar::dofs_per_cell; ++k){
+					const double value = fe_eval.begin_dof_values()[k][lane];
+					if (value <= window_min[i]) below = true;
+					else if (value >= window_max[i]) above = true;
+					else inside = true;
+				}
+				if (inside || (below && above)){
+					interfaceMask[cell][lane] = 1.0;
+				}
+			}
+		}
+	}
+
+	// Dilate the interface cells by one layer: the lanes of the cells sharing a DOF with an interface cell (all the fields share the mesh,
+	// so the first field gives the neighbors)
+	AlignedVector<scalarType> activeMask(interfaceMask);
+	{
+		vectorType indicator;
+		matrixFreeObject.initialize_dof_vector(indicator, 0);
+		indicator = 0.0;
+		if (fields[0].type == SCALAR){
+			typeScalar fe_eval(matrixFreeObject, 0);
+			markActiveRegionDOFs(fe_eval, interfaceMask, indicator);
+			indicator.compress(VectorOperation::add);
+			indicator.update_ghost_values();
+			findMarkedLanes(matrixFreeObject, fe_eval, indicator, activeMask);
+		}
+		else {
+			typeVector fe_eval(matrixFreeObject, 0);
+			markActiveRegionDOFs(fe_eval, interfaceMask, indicator);
+			indicator.compress(VectorOperation::add);
+			indicator.update_ghost_values();
+			findMarkedLanes(matrixFreeObject, fe_eval, indicator, activeMask);
+		}
+	}
+
+	// Mark the DOFs of the active cells for each field, and find the cell batches sharing a DOF with them
+	activeRegionIndicatorSet.resize(fields.size());
+	activeCellBatchSet.assign(n_cells, false);
+	for (unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		vectorType &indicator = activeRegionIndicatorSet[fieldIndex];
+		matrixFreeObject.initialize_dof_vector(indicator, fieldIndex);
+		indicator = 0.0;
+		if (fields[fieldIndex].type == SCALAR){
+			typeScalar fe_eval(matrixFreeObject, fieldIndex);
+			markActiveRegionDOFs(fe_eval, activeMask, indicator);
+			indicator.compress(VectorOperation::add);
+			indicator.update_ghost_values();
+			findActiveCellBatches(fe_eval, indicator, activeCellBatchSet);
+		}
+		else {
+			typeVector fe_eval(matrixFreeObject, fieldIndex);
+			markActiveRegionDOFs(fe_eval, activeMask, indicator);
+			indicator.compress(VectorOperation::add);
+			indicator.update_ghost_values();
+			findActiveCellBatches(fe_eval, indicator, activeCellBatchSet);
+		}
+	}
+
+	if (currentIncrement%skipPrintSteps==0){
+		unsigned int n_active = 0;
+		for (unsigned int cell=0; cell<n_cells; ++cell){
+			if (activeCellBatchSet[cell]) n_active++;
+		}
+		char buffer[200];
+		sprintf(buffer, "active region: %u of %u cell batches evaluated (on process 0)\n", n_active, n_cells);
+		pcout << buffer;
+	}
+}
+
+//set the residuals of the DOFs outside the active region to those of a stationary solution: the explicit update of the PARABOLIC
+//fields then keeps their values, and the increment of the ELLIPTIC fields has no source there
+template <int dim>
+void MatrixFreePDE<dim>::freezeInactiveRegion(){
+	const unsigned int invM_size = invM.local_size();
+	for (unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		const vectorType &indicator = activeRegionIndicatorSet[fieldIndex];
+		const vectorType &U = *solutionSet[fieldIndex];
+		vectorType &R = *residualSet[fieldIndex];
+		for (unsigned int dof=0; dof<R.local_size(); ++dof){
+			if (indicator.local_element(dof) > 0.0) continue;
+			if ((fields[fieldIndex].pdetype == PARABOLIC) && (invM.local_element(dof%invM_size) != 0.0)){
+				R.local_element(dof) = U.local_element(dof)/invM.local_element(dof%invM_size);
+			}
+			else {
+				R.local_element(dof) = 0.0;
+			}
+		}
+	}
+}
+
+//whether getRHS evaluates the given cell batch
+template <int dim>
+bool MatrixFreePDE<dim>::isActiveCellBatch(const unsigned int cell) const{
+	return activeCellBatchSet.empty() || activeCellBatchSet[cell];
+}
+
+#endif
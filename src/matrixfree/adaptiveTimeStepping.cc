@@ -0,0 +1,286 @@
+//adaptive time stepping methods for MatrixFreePDE class
+
+#ifndef ADAPTIVETIMESTEPPING_MATRIXFREE_H
+#define ADAPTIVETIMESTEPPING_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//The PARABOLIC fields are advanced with the embedded Bogacki-Shampine 3(2) Runge-Kutta pair. The residuals are
+//written for a forward Euler step of size timeStep (invM*R(u) = u + timeStep*du/dt), so the time derivative at a
+//stage is recovered from one call to computeRHS() as du/dt = (invM*R(u)-u)/timeStep. Fields listed in
+//auxiliaryFields (e.g. the chemical potential of a split Cahn-Hilliard equation) are not integrated in time, they
+//are set to invM*R(u) before each stage.
+
+//set the solution vectors to the RK stage y0 + h*sum_j(coefficients[j]*k_j)
+template <int dim>
+void MatrixFreePDE<dim>::setTimeStepStage(const double h, const std::vector<double> &coefficients){
+	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		if (isAuxiliaryField[fieldIndex]) continue;
+		vectorType &U = *solutionSet[fieldIndex];
+		U = rkVectorSet[fieldIndex][0];
+		for (unsigned int j=0; j<coefficients.size(); j++){
+			if (coefficients[j] != 0.0){
+				U.add(h*coefficients[j], rkVectorSet[fieldIndex][j+1]);
+			}
+		}
+	}
+
+	// Apply the constraints and ghost the solution vectors
+	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		constraintsOtherSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
+		constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
+		solutionSet[fieldIndex]->update_ghost_values();
+	}
+}
+
+//compute the time derivatives k_stage of the time integrated fields at the current solution vectors
+template <int dim>
+void MatrixFreePDE<dim>::computeTimeDerivatives(const unsigned int stage, const double baseTimeStep){
+	const unsigned int invM_size = invM.local_size();
+
+	// Update the auxiliary fields for the current state of the time integrated fields
+	if (std::find(isAuxiliaryField.begin(), isAuxiliaryField.end(), true) != isAuxiliaryField.end()){
+		computeRHS();
+		for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+			if (!isAuxiliaryField[fieldIndex]) continue;
+			vectorType &U = *solutionSet[fieldIndex];
+			const vectorType &R = *residualSet[fieldIndex];
+			const unsigned int n_blocks = U.local_size()/invM_size;
+			for (unsigned int block=0; block<n_blocks; block++){
+				for (unsigned int dof=0; dof<invM_size; ++dof){
+					U.local_element(block*invM_size+dof) = invM.local_element(dof)*R.local_element(block*invM_size+dof);
+				}
+			}
+			constraintsOtherSet[fieldIndex]->distribute(U);
+			constraintsDirichletSet[fieldIndex]->distribute(U);
+			U.update_ghost_values();
+		}
+	}
+
+	// du/dt = (invM*R(u)-u)/timeStep, zero on the DOFs without a mass matrix entry (hanging node DOFs), which follow from the constraints
+	computeRHS();
+	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		if (isAuxiliaryField[fieldIndex]) continue;
+		vectorType &k = rkVectorSet[fieldIndex][stage];
+		const vectorType &U = *solutionSet[fieldIndex];
+		const vectorType &R = *residualSet[fieldIndex];
+		const unsigned int n_blocks = U.local_size()/invM_size;
+		for (unsigned int block=0; block<n_blocks; block++){
+			for (unsigned int dof=0; dof<invM_size; ++dof){
+				const unsigned int i = block*invM_size+dof;
+				if (invM.local_element(dof) == 0.0){
+					k.local_element(i) = 0.0;
+				}
+				else {
+					k.local_element(i) = (invM.local_element(dof)*R.local_element(i) - U.local_element(i))/baseTimeStep;
+				}
+			}
+		}
+	}
+}
+
+//time stepping loop with adaptive time steps
+template <int dim>
+void MatrixFreePDE<dim>::solveAdaptiveTimeSteps(int &currentOutput){
+	char buffer[200];
+
+	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		if (fields[fieldIndex].pdetype != PARABOLIC){
+			pcout << "\nError: adaptiveTimeStepping is only implemented for problems where all the fields are PARABOLIC.\n\n";
+			exit(-1);
+		}
+	}
+
+	if (std::find(isIMEXField.begin(), isIMEXField.end(), true) != isIMEXField.end()){
+		pcout << "\nError: adaptiveTimeStepping cannot be combined with imexFields.\n\n";
+		exit(-1);
+	}
+
+	// Mark the auxiliary fields
+	isAuxiliaryField.assign(fields.size(), false);
+	{
+		std::stringstream auxiliaryFieldNames(auxiliaryFields);
+		std::string name;
+		while (std::getline(auxiliaryFieldNames, name, ',')){
+			name.erase(0, name.find_first_not_of(" "));
+			name.erase(name.find_last_not_of(" ")+1);
+			if (!name.empty()){
+				isAuxiliaryField[getFieldIndex(name)] = true;
+			}
+		}
+	}
+
+	// Bogacki-Shampine 3(2) pair (first same as last), the stages are k1...k4
+	std::vector<std::vector<double> > a(4);
+	a[1].push_back(0.5);
+	a[2].push_back(0.0); a[2].push_back(0.75);
+	a[3].push_back(2.0/9.0); a[3].push_back(1.0/3.0); a[3].push_back(4.0/9.0);
+	const double e[4] = {-5.0/72.0, 1.0/12.0, 1.0/9.0, -1.0/8.0};
+	const double controllerOrder = 3.0;
+
+	// The residuals are written for a forward Euler step of size timeStep, which is also the initial step size.
+	// The output times are the times of the output increments for that step size.
+	const double baseTimeStep = dtValue;
+	const double endTime = totalIncrements*baseTimeStep;
+	double proposedTimeStep = baseTimeStep;
+	double previousError = 1.0;
+	bool isFSALValid = false;
+
+	pcout << "\nAdaptive time stepping parameters: initial timeStep: " << baseTimeStep << "  timeFinal: " << endTime << "  relative tolerance: " << timeStepRelTol << "  absolute tolerance: " << timeStepAbsTol << "\n";
+
+	currentIncrement=0;
+	while (currentTime < endTime - 1.0e-12*baseTimeStep){
+		currentIncrement++;
+
+		//check and perform adaptive mesh refinement
+		computing_timer.enter_section("matrixFreePDE: AMR");
+		adaptiveRefine(currentIncrement);
+		computing_timer.exit_section("matrixFreePDE: AMR");
+
+		computing_timer.enter_section("matrixFreePDE: solveIncrements");
+
+		// (Re)allocate the stage vectors, reinit() clears them
+		if (rkVectorSet.size() != fields.size()){
+			rkVectorSet.resize(fields.size());
+			for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+				rkVectorSet[fieldIndex].resize(5);
+				for (unsigned int stage=0; stage<5; stage++){
+					matrixFreeObject.initialize_dof_vector(rkVectorSet[fieldIndex][stage], fieldIndex);
+				}
+			}
+			isFSALValid = false;
+		}
+
+		//modify fields (rarely used. Typically used in problems involving nucleation)
+		#ifdef nucleation_occurs
+		if (nucleation_occurs == true){
+			modifySolutionFields();
+			isFSALValid = false;
+		}
+		#endif
+
+		//grain tracking and remapping of the order parameters
+		if ((grainRemapping) && (currentIncrement%skipGrainRemappingSteps==0)){
+			remapGrains();
+			isFSALValid = false;
+		}
+
+		// Stage k1 (reused from the last stage of the previous step)
+		for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+			rkVectorSet[fieldIndex][0] = *solutionSet[fieldIndex];
+		}
+		if (!isFSALValid){
+			computeTimeDerivatives(1, baseTimeStep);
+		}
+
+		// Next output time
+		double nextOutputTime = endTime;
+		if (writeOutput && (currentOutput < (int)outputTimeStepList.size())){
+			nextOutputTime = std::min(endTime, outputTimeStepList[currentOutput]*baseTimeStep);
+		}
+
+		// Attempt steps until the error estimate is within the tolerances
+		bool accepted = false;
+		unsigned int rejectedSteps = 0;
+		while (!accepted){
+			double h = std::min(proposedTimeStep, maxTimeStep);
+			bool landsOnOutput = false;
+			if (currentTime + h >= nextOutputTime - 1.0e-12*baseTimeStep){
+				h = nextOutputTime - currentTime;
+				landsOnOutput = true;
+			}
+
+			for (unsigned int stage=1; stage<4; stage++){
+				setTimeStepStage(h, a[stage]);
+				computeTimeDerivatives(stage+1, baseTimeStep);
+			}
+
+			// Scaled RMS norm of the error estimate over the DOFs with a mass matrix entry, with a single reduction
+			const unsigned int invM_size = invM.local_size();
+			std::vector<double> localError(2, 0.0), globalError(2, 0.0);
+			for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+				if (isAuxiliaryField[fieldIndex]) continue;
+				const std::vector<vectorType> &rk = rkVectorSet[fieldIndex];
+				const vectorType &U = *solutionSet[fieldIndex];
+				for (unsigned int dof=0; dof<U.local_size(); ++dof){
+					if (invM.local_element(dof%invM_size) == 0.0) continue;
+					double error = h*(e[0]*rk[1].local_element(dof) + e[1]*rk[2].local_element(dof) + e[2]*rk[3].local_element(dof) + e[3]*rk[4].local_element(dof));
+					double scale = timeStepAbsTol + timeStepRelTol*std::max(std::abs(rk[0].local_element(dof)), std::abs(U.local_element(dof)));
+					localError[0] += (error/scale)*(error/scale);
+					localError[1] += 1.0;
+				}
+			}
+			Utilities::MPI::sum(localError, MPI_COMM_WORLD, globalError);
+			double error = std::sqrt(globalError[0]/globalError[1]);
+
+			if (numbers::is_finite(error) && (error <= 1.0)){
+				// PI step size controller
+				accepted = true;
+				error = std::max(error, 1.0e-10);
+				double factor = 0.9*std::pow(error, -0.7/controllerOrder)*std::pow(previousError, 0.4/controllerOrder);
+				factor = std::min(5.0, std::max(0.2, factor));
+				previousError = error;
+				if (!landsOnOutput || (h >= proposedTimeStep)){
+					proposedTimeStep = h*factor;
+				}
+
+				currentTime = (landsOnOutput ? nextOutputTime : currentTime + h);
+				dtValue = h;
+				for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+					rkVectorSet[fieldIndex][1].swap(rkVectorSet[fieldIndex][4]);
+				}
+				isFSALValid = true;
+			}
+			else {
+				// Reject the step, restore the solution at the start of the step
+				rejectedSteps++;
+				double factor = (numbers::is_finite(error) ? std::max(0.2, 0.9*std::pow(error, -1.0/controllerOrder)) : 0.2);
+				proposedTimeStep = h*factor;
+				if (proposedTimeStep < minTimeStep){
+					sprintf(buffer, "ERROR: adaptive time step %12.6e is smaller than minTimeStep (error estimate: %12.6e). exiting.\n\n", proposedTimeStep, error);
+					pcout << buffer;
+					exit(-1);
+				}
+				std::vector<double> noCoefficients;
+				setTimeStepStage(0.0, noCoefficients);
+				for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+					if (isAuxiliaryField[fieldIndex]){
+						*solutionSet[fieldIndex] = rkVectorSet[fieldIndex][0];
+						solutionSet[fieldIndex]->update_ghost_values();
+					}
+				}
+			}
+		}
+
+		if (currentIncrement%skipPrintSteps==0){
+			sprintf(buffer, "\ntime increment:%u  time: %12.6e  timeStep: %12.6e  next timeStep: %12.6e  rejected steps: %u\n", \
+					currentIncrement, currentTime, dtValue, proposedTimeStep, rejectedSteps);
+			pcout << buffer;
+			for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+				sprintf(buffer, "field '%2s' [%s]: current solution: %12.6e\n", \
+						fields[fieldIndex].name.c_str(), (isAuxiliaryField[fieldIndex] ? "auxiliary" : "RK3(2)"), \
+						solutionSet[fieldIndex]->l2_norm());
+				pcout << buffer;
+			}
+		}
+
+		computing_timer.exit_section("matrixFreePDE: solveIncrements");
+
+		//output results to file, named after the increment of the output time for the initial step size
+		if (writeOutput && (currentOutput < (int)outputTimeStepList.size()) && (std::abs(currentTime - outputTimeStepList[currentOutput]*baseTimeStep) < 1.0e-12*baseTimeStep)){
+			unsigned int acceptedIncrements = currentIncrement;
+			currentIncrement = outputTimeStepList[currentOutput];
+			outputResults();
+			#ifdef calcEnergy
+			if (calcEnergy == true){
+				computeEnergy();
+				outputFreeEnergy(freeEnergyValues);
+			}
+			#endif
+			currentIncrement = acceptedIncrements;
+			currentOutput++;
+		}
+	}
+}
+
+#endif
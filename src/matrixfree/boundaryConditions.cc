@@ -15,6 +15,23 @@ void MatrixFreePDE<dim>::applyDirichletBCs(){
 					    *(ConstraintMatrix*) this->constraintsDirichletSet[currentFieldIndex]);
 }
 
+//store the locally owned DOF's with Dirichlet BC's of a field as local indices and values. Only the locally owned DOF's
+//are visited, so the cost per process depends on the local problem size and not on the global number of DOF's.
+template <int dim>
+void MatrixFreePDE<dim>::storeDirichletDOFs(const unsigned int fieldIndex){
+  const IndexSet & locally_owned_dofs = dofHandlersSet[fieldIndex]->locally_owned_dofs();
+  const ConstraintMatrix & constraintsDirichlet = *constraintsDirichletSet[fieldIndex];
+  dirichletLocalIndicesSet[fieldIndex].clear();
+  dirichletLocalValuesSet[fieldIndex].clear();
+  for (unsigned int localIndex=0; localIndex<locally_owned_dofs.n_elements(); localIndex++){
+    const types::global_dof_index dof = locally_owned_dofs.nth_index_in_set(localIndex);
+    if (constraintsDirichlet.is_constrained(dof)){
+      dirichletLocalIndicesSet[fieldIndex].push_back(localIndex);
+      dirichletLocalValuesSet[fieldIndex].push_back(constraintsDirichlet.get_inhomogeneity(dof));
+    }
+  }
+}
+
 // Based on the contents of BC_list, mark faces on the triangulation as periodic
 template <int dim>
 void MatrixFreePDE<dim>::setPeriodicity(){
@@ -33,7 +33,7 @@ void MatrixFreePDE<dim>::computeEnergy(){
 }
 
 template <int dim>
-void  MatrixFreePDE<dim>::getEnergy(const MatrixFree<dim,double> &data,
+void  MatrixFreePDE<dim>::getEnergy(const MatrixFree<dim,numberType> &data,
 				    std::vector<vectorType*> &dst,
 				    const std::vector<vectorType*> &src,
 				    const std::pair<unsigned int,unsigned int> &cell_range) {
@@ -10,29 +10,61 @@ void MatrixFreePDE<dim>::vmult (vectorType &dst, const vectorType &src) const{
   //log time
   computing_timer.enter_section("matrixFreePDE: computeLHS");
 
-  //create temporary copy of src vector as src2, as vector src is marked const and cannot be changed
-  vectorType src2;
-  matrixFreeObject.initialize_dof_vector(src2,  currentFieldIndex);
+  //copy src vector into the scratch vector src2, as vector src is marked const and cannot be changed
+  vectorType &src2=vmultScratchSet[currentFieldIndex];
   src2=src;
   
   //set Dirichlet nodes force to zero in the src
-  for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[currentFieldIndex]->begin(); it!=valuesDirichletSet[currentFieldIndex]->end(); ++it){
-    if (src2.in_local_range(it->first)){
-      src2(it->first) = 0.0; //*jacobianDiagonal(it->first);
-    }
+  const std::vector<unsigned int> &dirichletIndices=dirichletLocalIndicesSet[currentFieldIndex];
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    src2.local_element(dirichletIndices[i]) = 0.0;
   }
   constraintsOtherSet[currentFieldIndex]->distribute(src2);
 
   //call cell_loop 
   dst=0.0;
-  matrixFreeObject.cell_loop (&MatrixFreePDE<dim>::getLHS, this, dst, src2);
-  dst.compress(VectorOperation::add);
+  if ((isIMEXField.size() > 0) && isIMEXField[currentFieldIndex]){
+    vmultIMEX(dst, src2);
+  }
+  else{
+    matrixFreeObject.cell_loop (&MatrixFreePDE<dim>::getLHS, this, dst, src2);
+    dst.compress(VectorOperation::add);
+  }
   
   //Account for Dirichlet BC's (essentially copy dirichlet DOF values present in src to dst)
-  for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[currentFieldIndex]->begin(); it!=valuesDirichletSet[currentFieldIndex]->end(); ++it){
-    if (dst.in_local_range(it->first)){
-      dst(it->first) = src(it->first); //*jacobianDiagonal(it->first);
-    }
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    dst.local_element(dirichletIndices[i]) = src.local_element(dirichletIndices[i]);
+  }
+
+  //end log
+  computing_timer.exit_section("matrixFreePDE: computeLHS");
+}
+
+//single precision vmult operation for LHS, used by the inner solves of the mixed precision implicit solves
+template <int dim>
+void MatrixFreePDE<dim>::vmult (floatVectorType &dst, const floatVectorType &src) const{
+  //log time
+  computing_timer.enter_section("matrixFreePDE: computeLHS");
+
+  //copy src vector into the scratch vector src2, as vector src is marked const and cannot be changed
+  floatVectorType &src2=mixedPrecisionScratchSet[currentFieldIndex].vmultSrc;
+  src2=src;
+
+  //set Dirichlet nodes force to zero in the src
+  const std::vector<unsigned int> &dirichletIndices=dirichletLocalIndicesSet[currentFieldIndex];
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    src2.local_element(dirichletIndices[i]) = 0.0;
+  }
+  constraintsOtherSet[currentFieldIndex]->distribute(src2);
+
+  //call cell_loop
+  dst=0.0;
+  matrixFreeObject.cell_loop (&MatrixFreePDE<dim>::getLHSSinglePrecision, this, dst, src2);
+  dst.compress(VectorOperation::add);
+
+  //Account for Dirichlet BC's (essentially copy dirichlet DOF values present in src to dst)
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    dst.local_element(dirichletIndices[i]) = src.local_element(dirichletIndices[i]);
   }
 
   //end log
@@ -40,7 +72,7 @@ void MatrixFreePDE<dim>::vmult (vectorType &dst, const vectorType &src) const{
 }
   
 template <int dim>
-void  MatrixFreePDE<dim>::getLHS(const MatrixFree<dim,double> &data, 
+void  MatrixFreePDE<dim>::getLHS(const MatrixFree<dim,numberType> &data, 
 				 vectorType &dst, 
 				 const vectorType &src,
 				 const std::pair<unsigned int,unsigned int> &cell_range) const{
@@ -48,6 +80,156 @@ void  MatrixFreePDE<dim>::getLHS(const MatrixFree<dim,double> &data,
   exit(-1);
 }
 
+template <int dim>
+void  MatrixFreePDE<dim>::getLHSBlock(const MatrixFree<dim,numberType> &data,
+				 vectorType &dst,
+				 const vectorType &src,
+				 const std::pair<unsigned int,unsigned int> &cell_range,
+				 const unsigned int fieldIndex,
+				 const unsigned int srcFieldIndex) const{
+  pcout << "\n\nError: computeLHS.cc: getLHSBlock() not implemented in the derived class, but is called\n";
+  exit(-1);
+}
+
+template <int dim>
+void  MatrixFreePDE<dim>::getLHSSinglePrecision(const MatrixFree<dim,numberType> &data,
+				 floatVectorType &dst,
+				 const floatVectorType &src,
+				 const std::pair<unsigned int,unsigned int> &cell_range) const{
+  pcout << "\n\nError: computeLHS.cc: getLHSSinglePrecision() not implemented in the derived class, but is called\n";
+  exit(-1);
+}
+
+template <int dim>
+void MatrixFreePDE<dim>::clearEvaluatorPools(){
+}
+
+template <int dim>
+void MatrixFreePDE<dim>::cacheLHSFields(unsigned int fieldIndex){
+}
+
+template <int dim>
+void MatrixFreePDE<dim>::clearLHSFieldCache(){
+}
+
+template <int dim>
+void  MatrixFreePDE<dim>::getLHSDiagonal(const MatrixFree<dim,numberType> &data,
+				 vectorType &dst,
+				 const vectorType &src,
+				 const std::pair<unsigned int,unsigned int> &cell_range) const{
+  pcout << "\n\nError: computeLHS.cc: getLHSDiagonal() not implemented in the derived class, but is called\n";
+  exit(-1);
+}
+
+//compute the inverse of the LHS diagonal for the elliptic fields, and the Chebyshev preconditioners built on it
+template <int dim>
+void MatrixFreePDE<dim>::computeLHSDiagonal(){
+  std::string preconditioner_type = preconditionerType;
+  if ((preconditioner_type != "JACOBI") && (preconditioner_type != "CHEBYSHEV")) return;
+
+  //log time
+  computing_timer.enter_section("matrixFreePDE: computeLHSDiagonal");
+
+  diagonalInverseSet.resize(fields.size(), NULL);
+  chebyshevPreconditionerSet.resize(fields.size(), NULL);
+  diagonalInverseSinglePrecisionSet.resize(fields.size(), NULL);
+  chebyshevPreconditionerSinglePrecisionSet.resize(fields.size(), NULL);
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+    if (fields[fieldIndex].pdetype!=ELLIPTIC) continue;
+    currentFieldIndex=fieldIndex; // Used in getLHSDiagonal()
+
+    if (diagonalInverseSet[fieldIndex]==NULL){
+      diagonalInverseSet[fieldIndex]=new DiagonalMatrix<vectorType>;
+    }
+    vectorType &diagonal=diagonalInverseSet[fieldIndex]->get_vector();
+    matrixFreeObject.initialize_dof_vector(diagonal, fieldIndex);
+
+    //call cell_loop (the source vector is not used by getLHSDiagonal)
+    vectorType src;
+    matrixFreeObject.initialize_dof_vector(src, fieldIndex);
+    matrixFreeObject.cell_loop (&MatrixFreePDE<dim>::getLHSDiagonal, this, diagonal, src);
+    diagonal.compress(VectorOperation::add);
+
+    //Dirichlet DOFs are identity rows in vmult, constrained DOFs have no diagonal entry
+    for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+      diagonal.local_element(dirichletLocalIndicesSet[fieldIndex][i]) = 1.0;
+    }
+    for (unsigned int dof=0; dof<diagonal.local_size(); ++dof){
+      if (std::abs(diagonal.local_element(dof))>1.0e-15){
+        diagonal.local_element(dof)=1.0/diagonal.local_element(dof);
+      }
+      else{
+        diagonal.local_element(dof)=1.0;
+      }
+    }
+
+    //Chebyshev-accelerated Jacobi, the eigenvalue estimate is done on the first application
+    if (preconditioner_type == "CHEBYSHEV"){
+      delete chebyshevPreconditionerSet[fieldIndex];
+      typename PreconditionChebyshev<MatrixFreePDE<dim>, vectorType>::AdditionalData chebyshevData;
+      chebyshevData.degree = chebyshevDegree;
+      chebyshevData.smoothing_range = chebyshevSmoothingRange;
+      chebyshevData.eig_cg_n_iterations = 10;
+      chebyshevData.matrix_diagonal_inverse = diagonal;
+      chebyshevPreconditionerSet[fieldIndex]=new PreconditionChebyshev<MatrixFreePDE<dim>, vectorType>;
+      chebyshevPreconditionerSet[fieldIndex]->initialize(*this, chebyshevData);
+    }
+
+    //single precision copies for the inner solves of the mixed precision implicit solves
+    if (mixedPrecisionEllipticSolves){
+      if (diagonalInverseSinglePrecisionSet[fieldIndex]==NULL){
+        diagonalInverseSinglePrecisionSet[fieldIndex]=new DiagonalMatrix<floatVectorType>;
+      }
+      floatVectorType &diagonalSinglePrecision=diagonalInverseSinglePrecisionSet[fieldIndex]->get_vector();
+      diagonalSinglePrecision.reinit(diagonal, true);
+      diagonalSinglePrecision=diagonal;
+
+      if (preconditioner_type == "CHEBYSHEV"){
+        delete chebyshevPreconditionerSinglePrecisionSet[fieldIndex];
+        typename PreconditionChebyshev<MatrixFreePDE<dim>, floatVectorType>::AdditionalData chebyshevData;
+        chebyshevData.degree = chebyshevDegree;
+        chebyshevData.smoothing_range = chebyshevSmoothingRange;
+        chebyshevData.eig_cg_n_iterations = 10;
+        chebyshevData.matrix_diagonal_inverse = diagonalSinglePrecision;
+        chebyshevPreconditionerSinglePrecisionSet[fieldIndex]=new PreconditionChebyshev<MatrixFreePDE<dim>, floatVectorType>;
+        chebyshevPreconditionerSinglePrecisionSet[fieldIndex]->initialize(*this, chebyshevData);
+      }
+    }
+  }
+
+  //end log
+  computing_timer.exit_section("matrixFreePDE: computeLHSDiagonal");
+}
+
+//matrix size of the field currently being solved
+template <int dim>
+types::global_dof_index MatrixFreePDE<dim>::m () const{
+  return solutionSet[currentFieldIndex]->size();
+}
+
+template <int dim>
+types::global_dof_index MatrixFreePDE<dim>::n () const{
+  return solutionSet[currentFieldIndex]->size();
+}
+
+template <int dim>
+double MatrixFreePDE<dim>::el (const types::global_dof_index i, const types::global_dof_index j) const{
+  pcout << "\n\nError: computeLHS.cc: el() is not available for the matrix free LHS operator\n";
+  exit(-1);
+  return 0.0;
+}
+
+//solution vectors to read the non-solved fields from in getLHS (level copies for the multigrid level operators)
+template <int dim>
+const std::vector<vectorType*> & MatrixFreePDE<dim>::getLHSFieldSet(const MatrixFree<dim,numberType> &data) const{
+  for (unsigned int level=0; level<mgMatrixFreeSet.size(); level++){
+    if (&data == mgMatrixFreeSet[level]){
+      return mgSolutionSet[level];
+    }
+  }
+  return solutionSet;
+}
+
 #endif
 
 
@@ -16,9 +16,25 @@ void MatrixFreePDE<dim>::computeRHS(){
     (*residualSet[fieldIndex])=0.0;
   }
 
+  // With activeRegionSkipping all the cell batches are evaluated (and the active region is updated) every activeRegionUpdateSteps
+  // increments, in between only the cell batches of the active region are evaluated
+  const bool evaluateAllCells = (activeRegionSkipping == false) || (currentIncrement%activeRegionUpdateSteps==0) || activeCellBatchSet.empty();
+  if (evaluateAllCells){
+    activeCellBatchSet.clear();
+  }
+
   //call to integrate and assemble 
   matrixFreeObject.cell_loop (&MatrixFreePDE<dim>::getRHS, this, residualSet, solutionSet);
 
+  if (activeRegionSkipping){
+    if (evaluateAllCells){
+      updateActiveRegion();
+    }
+    else {
+      freezeInactiveRegion();
+    }
+  }
+
   //end log
   computing_timer.exit_section("matrixFreePDE: computeRHS");
 }
@@ -0,0 +1,430 @@
+//grain tracking and order parameter remapping methods for MatrixFreePDE class
+
+#ifndef GRAINREMAPPING_MATRIXFREE_H
+#define GRAINREMAPPING_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//With grainRemapping, the grains are found as the connected regions of the cells where one of the grainRemappingFields (the order
+//parameters) exceeds grainThreshold. Each process labels the connected regions of its locally owned and ghost cells (flood fill through
+//the cell faces), and the labels of the regions that continue on other processes are merged by exchanging the labels of the ghost cells
+//until every grain carries the smallest label of its regions. The cells of a grain with a face outside the grain (its boundary cells) are
+//gathered on all the processes. Two grains of the same order parameter are too close when the separation of their boundary cells is below
+//grainBufferDistance. One of them is then moved to the order parameter with the largest separation from its grains, by adding its values
+//and those of the cells next to it (the tail of the order parameter below grainThreshold) to that field and setting them to zero in the
+//original field. Every process holds the same list of grains, so the remapping decisions need no further communication.
+
+//bounding box, boundary cells, volume and order parameter of a grain
+template <int dim>
+struct grainRegion {
+	unsigned int field;
+	double label, volume;
+	Point<dim> lo, hi;
+	bool touchesBoundary;
+	// Centers and circumradii of the boundary cells
+	std::vector<Point<dim> > boundaryCenters;
+	std::vector<double> boundaryRadii;
+};
+
+//separation of two grains: the smallest distance between their boundary cells, with each cell taken as the ball around its center
+//that contains it (zero if the cells overlap). The separation of the bounding boxes is a lower bound that skips the distant grains.
+template <int dim>
+double grainSeparation(const grainRegion<dim> &a, const grainRegion<dim> &b){
+	double dist2 = 0.0;
+	for (unsigned int d=0; d<dim; d++){
+		double gap = std::max(a.lo[d]-b.hi[d], b.lo[d]-a.hi[d]);
+		if (gap > 0.0) dist2 += gap*gap;
+	}
+	if (std::sqrt(dist2) > grainBufferDistance) return std::sqrt(dist2);
+
+	double separation = std::numeric_limits<double>::max();
+	for (unsigned int i=0; i<a.boundaryCenters.size(); i++){
+		for (unsigned int j=0; j<b.boundaryCenters.size(); j++){
+			const double gap = a.boundaryCenters[i].distance(b.boundaryCenters[j]) - a.boundaryRadii[i] - b.boundaryRadii[j];
+			separation = std::min(separation, std::max(gap, 0.0));
+		}
+	}
+	return separation;
+}
+
+//active cells sharing a face with the given cell, as active cell indices
+template <int dim>
+void activeFaceNeighbors(const typename Triangulation<dim>::active_cell_iterator &cell, std::vector<unsigned int> &neighbors){
+	neighbors.clear();
+	for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f){
+		if (cell->at_boundary(f)) continue;
+		typename Triangulation<dim>::cell_iterator neighbor = cell->neighbor(f);
+		if (!neighbor->has_children()){
+			if (!neighbor->is_artificial()) neighbors.push_back(neighbor->active_cell_index());
+		}
+		else if (dim == 1){
+			while (neighbor->has_children()) neighbor = neighbor->child(1-f);
+			if (!neighbor->is_artificial()) neighbors.push_back(neighbor->active_cell_index());
+		}
+		else {
+			for (unsigned int sf=0; sf<cell->face(f)->n_children(); ++sf){
+				typename Triangulation<dim>::cell_iterator child = cell->neighbor_child_on_subface(f, sf);
+				if (!child->is_artificial()) neighbors.push_back(child->active_cell_index());
+			}
+		}
+	}
+}
+
+//find the grains of the grainRemappingFields and remap the grains that are too close to another grain of the same field
+template <int dim>
+void MatrixFreePDE<dim>::remapGrains(){
+	computing_timer.enter_section("matrixFreePDE: grainRemapping");
+
+	std::vector<int> remapping_fields;
+	{int temp[] = grainRemappingFields;
+	vectorLoad(temp, sizeof(temp), remapping_fields);}
+	for (unsigned int i=0; i<remapping_fields.size(); i++){
+		if (fields[remapping_fields[i]].type != SCALAR){
+			pcout << "\nError: the grainRemappingFields must be SCALAR fields.\n\n";
+			exit(-1);
+		}
+	}
+
+	const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+	const unsigned int this_proc = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+	// Locally owned and ghost cells, indexed by their active cell index
+	const unsigned int n_active = triangulation.n_active_cells();
+	std::vector<typename Triangulation<dim>::active_cell_iterator> cells(n_active);
+	std::vector<bool> isVisible(n_active, false);
+	for (typename Triangulation<dim>::active_cell_iterator cell=triangulation.begin_active(); cell!=triangulation.end(); ++cell){
+		if (cell->is_artificial()) continue;
+		cells[cell->active_cell_index()] = cell;
+		isVisible[cell->active_cell_index()] = true;
+	}
+
+	// One DOF per cell, owned by the owner of the cell, to exchange the region labels of the ghost cells
+	FE_DGQ<dim> fe_label(0);
+	DoFHandler<dim> labelDoFHandler(triangulation);
+	labelDoFHandler.distribute_dofs(fe_label);
+	IndexSet relevant_label_dofs;
+	DoFTools::extract_locally_relevant_dofs(labelDoFHandler, relevant_label_dofs);
+	vectorType labels(labelDoFHandler.locally_owned_dofs(), relevant_label_dofs, MPI_COMM_WORLD);
+	std::vector<types::global_dof_index> labelDoF(n_active, 0), dof_index(1);
+	for (typename DoFHandler<dim>::active_cell_iterator cell=labelDoFHandler.begin_active(); cell!=labelDoFHandler.end(); ++cell){
+		if (cell->is_artificial()) continue;
+		cell->get_dof_indices(dof_index);
+		labelDoF[cell->active_cell_index()] = dof_index[0];
+	}
+
+	// Domain box, used to flag the grains at the domain boundary
+	Point<dim> domain_lo, domain_hi;
+	{std::vector<double> extent(2*dim, -std::numeric_limits<double>::max()), global_extent(2*dim);
+	for (unsigned int c=0; c<n_active; c++){
+		if (!isVisible[c] || !cells[c]->is_locally_owned()) continue;
+		for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v){
+			for (unsigned int d=0; d<dim; d++){
+				extent[d] = std::max(extent[d], -cells[c]->vertex(v)[d]);
+				extent[dim+d] = std::max(extent[dim+d], cells[c]->vertex(v)[d]);
+			}
+		}
+	}
+	Utilities::MPI::max(extent, MPI_COMM_WORLD, global_extent);
+	for (unsigned int d=0; d<dim; d++){
+		domain_lo[d] = -global_extent[d];
+		domain_hi[d] = global_extent[dim+d];
+	}}
+
+	std::vector<grainRegion<dim> > grains;
+	// Region of each visible cell (-1 outside the grains) and final label of each region, for each remapping field
+	std::vector<std::vector<int> > cellRegionSet(remapping_fields.size());
+	std::vector<std::vector<double> > regionLabelSet(remapping_fields.size());
+	std::vector<unsigned int> neighbors;
+
+	for (unsigned int i=0; i<remapping_fields.size(); i++){
+		const unsigned int fieldIndex = remapping_fields[i];
+		std::vector<int> &cellRegion = cellRegionSet[i];
+		std::vector<double> &regionLabel = regionLabelSet[i];
+		solutionSet[fieldIndex]->update_ghost_values();
+
+		// Cells inside the grains of the field
+		std::vector<bool> inGrain(n_active, false);
+		Vector<double> local_values(FESet[fieldIndex]->dofs_per_cell);
+		for (typename DoFHandler<dim>::active_cell_iterator cell=dofHandlersSet[fieldIndex]->begin_active(); cell!=dofHandlersSet[fieldIndex]->end(); ++cell){
+			if (cell->is_artificial()) continue;
+			cell->get_dof_values(*solutionSet[fieldIndex], local_values);
+			inGrain[cell->active_cell_index()] = (local_values.linfty_norm() > grainThreshold);
+		}
+
+		// Flood fill of the visible cells
+		cellRegion.assign(n_active, -1);
+		unsigned int n_regions = 0;
+		std::vector<unsigned int> front;
+		for (unsigned int c=0; c<n_active; c++){
+			if (!inGrain[c] || (cellRegion[c] >= 0)) continue;
+			cellRegion[c] = n_regions;
+			front.assign(1, c);
+			while (!front.empty()){
+				const unsigned int current = front.back();
+				front.pop_back();
+				activeFaceNeighbors<dim>(cells[current], neighbors);
+				for (unsigned int n=0; n<neighbors.size(); n++){
+					if (inGrain[neighbors[n]] && (cellRegion[neighbors[n]] < 0)){
+						cellRegion[neighbors[n]] = n_regions;
+						front.push_back(neighbors[n]);
+					}
+				}
+			}
+			n_regions++;
+		}
+
+		// Globally unique initial labels
+		std::vector<double> regionCounts(n_procs, 0.0), globalRegionCounts(n_procs);
+		regionCounts[this_proc] = n_regions;
+		Utilities::MPI::sum(regionCounts, MPI_COMM_WORLD, globalRegionCounts);
+		double offset = 0.0, n_global_regions = 0.0;
+		for (unsigned int p=0; p<n_procs; p++){
+			if (p < this_proc) offset += globalRegionCounts[p];
+			n_global_regions += globalRegionCounts[p];
+		}
+		regionLabel.resize(n_regions);
+		for (unsigned int r=0; r<n_regions; r++){
+			regionLabel[r] = offset + r;
+		}
+
+		// Merge the regions across the processes: each region takes the smallest label of the ghost cells it contains,
+		// which passes the smallest label of a grain over one process boundary per exchange
+		bool changed = true;
+		while (changed){
+			labels.zero_out_ghosts();
+			labels = -1.0;
+			for (unsigned int c=0; c<n_active; c++){
+				if (isVisible[c] && cells[c]->is_locally_owned() && (cellRegion[c] >= 0)){
+					labels(labelDoF[c]) = regionLabel[cellRegion[c]];
+				}
+			}
+			labels.update_ghost_values();
+			unsigned int localChanges = 0;
+			for (unsigned int c=0; c<n_active; c++){
+				if (!isVisible[c] || !cells[c]->is_ghost() || (cellRegion[c] < 0)) continue;
+				const double ghostLabel = labels(labelDoF[c]);
+				if ((ghostLabel >= 0.0) && (ghostLabel < regionLabel[cellRegion[c]])){
+					regionLabel[cellRegion[c]] = ghostLabel;
+					localChanges++;
+				}
+			}
+			changed = (Utilities::MPI::sum(localChanges, MPI_COMM_WORLD) > 0);
+		}
+
+		// Volume and bounding box of each grain from the locally owned cells, indexed by the grain label
+		const unsigned int n_labels = (unsigned int) n_global_regions;
+		if (n_labels == 0) continue;
+		std::vector<double> volume(n_labels, 0.0), globalVolume(n_labels);
+		std::vector<double> extent(2*dim*n_labels, -std::numeric_limits<double>::max()), globalExtent(2*dim*n_labels);
+		for (unsigned int c=0; c<n_active; c++){
+			if (!isVisible[c] || !cells[c]->is_locally_owned() || (cellRegion[c] < 0)) continue;
+			const unsigned int label = (unsigned int) regionLabel[cellRegion[c]];
+			volume[label] += cells[c]->measure();
+			for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v){
+				for (unsigned int d=0; d<dim; d++){
+					extent[2*dim*label+d] = std::max(extent[2*dim*label+d], -cells[c]->vertex(v)[d]);
+					extent[2*dim*label+dim+d] = std::max(extent[2*dim*label+dim+d], cells[c]->vertex(v)[d]);
+				}
+			}
+		}
+		Utilities::MPI::sum(volume, MPI_COMM_WORLD, globalVolume);
+		Utilities::MPI::max(extent, MPI_COMM_WORLD, globalExtent);
+
+		// Label, center and circumradius of the locally owned boundary cells of the grains, gathered on all the processes
+		const unsigned int stride = dim+2;
+		std::vector<double> boundaryCells, globalBoundaryCells;
+		for (unsigned int c=0; c<n_active; c++){
+			if (!isVisible[c] || !cells[c]->is_locally_owned() || (cellRegion[c] < 0)) continue;
+			bool isBoundaryCell = cells[c]->at_boundary();
+			activeFaceNeighbors<dim>(cells[c], neighbors);
+			for (unsigned int n=0; (n<neighbors.size()) && !isBoundaryCell; n++){
+				if (!inGrain[neighbors[n]]) isBoundaryCell = true;
+			}
+			if (!isBoundaryCell) continue;
+			boundaryCells.push_back(regionLabel[cellRegion[c]]);
+			const Point<dim> center = cells[c]->center();
+			for (unsigned int d=0; d<dim; d++){
+				boundaryCells.push_back(center[d]);
+			}
+			boundaryCells.push_back(0.5*cells[c]->diameter());
+		}
+		int n_local_entries = boundaryCells.size();
+		std::vector<int> entryCounts(n_procs), entryOffsets(n_procs, 0);
+		MPI_Allgather(&n_local_entries, 1, MPI_INT, &entryCounts[0], 1, MPI_INT, MPI_COMM_WORLD);
+		for (unsigned int p=1; p<n_procs; p++){
+			entryOffsets[p] = entryOffsets[p-1] + entryCounts[p-1];
+		}
+		globalBoundaryCells.resize(entryOffsets[n_procs-1] + entryCounts[n_procs-1]);
+		MPI_Allgatherv((boundaryCells.empty() ? NULL : &boundaryCells[0]), n_local_entries, MPI_DOUBLE,
+				(globalBoundaryCells.empty() ? NULL : &globalBoundaryCells[0]), &entryCounts[0], &entryOffsets[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+		std::vector<int> grainOfLabel(n_labels, -1);
+		for (unsigned int label=0; label<n_labels; label++){
+			if (globalVolume[label] <= 0.0) continue;
+			grainOfLabel[label] = grains.size();
+			grainRegion<dim> grain;
+			grain.field = fieldIndex;
+			grain.label = label;
+			grain.volume = globalVolume[label];
+			grain.touchesBoundary = false;
+			for (unsigned int d=0; d<dim; d++){
+				grain.lo[d] = -globalExtent[2*dim*label+d];
+				grain.hi[d] = globalExtent[2*dim*label+dim+d];
+				const double tol = 1.0e-8*(domain_hi[d]-domain_lo[d]);
+				if ((grain.lo[d] <= domain_lo[d]+tol) || (grain.hi[d] >= domain_hi[d]-tol)) grain.touchesBoundary = true;
+			}
+			grains.push_back(grain);
+		}
+		for (unsigned int e=0; e<globalBoundaryCells.size(); e+=stride){
+			const int g = grainOfLabel[(unsigned int) globalBoundaryCells[e]];
+			if (g < 0) continue;
+			Point<dim> center;
+			for (unsigned int d=0; d<dim; d++){
+				center[d] = globalBoundaryCells[e+1+d];
+			}
+			grains[g].boundaryCenters.push_back(center);
+			grains[g].boundaryRadii.push_back(globalBoundaryCells[e+1+dim]);
+		}
+	}
+
+	// Remap one grain of each pair of grains of the same field that are too close, preferring the grains away from the domain boundary
+	// (which may continue across a periodic boundary) and then the smaller grain
+	std::vector<unsigned int> originalField(grains.size());
+	for (unsigned int g=0; g<grains.size(); g++){
+		originalField[g] = grains[g].field;
+	}
+	unsigned int n_remapped = 0, n_unresolved = 0;
+	for (unsigned int g=0; g<grains.size(); g++){
+		for (unsigned int h=g+1; h<grains.size(); h++){
+			if ((grains[g].field != grains[h].field) || (grainSeparation(grains[g], grains[h]) > grainBufferDistance)) continue;
+
+			unsigned int moved = h;
+			if (grains[g].touchesBoundary != grains[h].touchesBoundary){
+				moved = (grains[g].touchesBoundary ? h : g);
+			}
+			else if (grains[g].volume < grains[h].volume){
+				moved = g;
+			}
+
+			// Field with the largest separation between the grain and its grains
+			int target = -1;
+			double targetSeparation = grainBufferDistance;
+			for (unsigned int i=0; i<remapping_fields.size(); i++){
+				if ((unsigned int) remapping_fields[i] == grains[moved].field) continue;
+				double separation = std::numeric_limits<double>::max();
+				for (unsigned int k=0; k<grains.size(); k++){
+					if (grains[k].field == (unsigned int) remapping_fields[i]){
+						separation = std::min(separation, grainSeparation(grains[moved], grains[k]));
+					}
+				}
+				if (separation > targetSeparation){
+					target = remapping_fields[i];
+					targetSeparation = separation;
+				}
+			}
+			if (target < 0){
+				n_unresolved++;
+				continue;
+			}
+			grains[moved].field = target;
+			n_remapped++;
+		}
+	}
+
+	// Move the values of the remapped grains and of the cells next to them (outside the grains of the field), at the locally owned DOFs of
+	// the visible cells
+	if (n_remapped > 0){
+		std::vector<bool> fieldChanged(fields.size(), false);
+		for (unsigned int i=0; i<remapping_fields.size(); i++){
+			const unsigned int fieldIndex = remapping_fields[i];
+			vectorType &U = *solutionSet[fieldIndex];
+
+			// Target field of the remapped grains of this field, by grain label
+			std::map<double, unsigned int> targetField;
+			for (unsigned int g=0; g<grains.size(); g++){
+				if ((originalField[g] == fieldIndex) && (grains[g].field != fieldIndex)){
+					targetField[grains[g].label] = grains[g].field;
+				}
+			}
+			if (targetField.empty()) continue;
+
+			// Target field of each locally owned cell of a remapped grain or next to one, exchanged through the cell-wise vector so
+			// that the processes seeing a cell only as a ghost cell also move its DOFs
+			labels.zero_out_ghosts();
+			labels = -1.0;
+			for (unsigned int c=0; c<n_active; c++){
+				if (!isVisible[c] || !cells[c]->is_locally_owned()) continue;
+				const int region = cellRegionSet[i][c];
+				if (region >= 0){
+					typename std::map<double, unsigned int>::const_iterator it = targetField.find(regionLabelSet[i][region]);
+					if (it != targetField.end()) labels(labelDoF[c]) = it->second;
+					continue;
+				}
+				activeFaceNeighbors<dim>(cells[c], neighbors);
+				for (unsigned int n=0; n<neighbors.size(); n++){
+					const int neighborRegion = cellRegionSet[i][neighbors[n]];
+					if (neighborRegion < 0) continue;
+					typename std::map<double, unsigned int>::const_iterator it = targetField.find(regionLabelSet[i][neighborRegion]);
+					if (it != targetField.end()){
+						labels(labelDoF[c]) = it->second;
+						break;
+					}
+				}
+			}
+			labels.update_ghost_values();
+
+			// The DOFs of the grains that stay in this field are kept
+			std::set<types::global_dof_index> keptDOFs;
+			std::vector<types::global_dof_index> local_dof_indices(FESet[fieldIndex]->dofs_per_cell);
+			for (typename DoFHandler<dim>::active_cell_iterator cell=dofHandlersSet[fieldIndex]->begin_active(); cell!=dofHandlersSet[fieldIndex]->end(); ++cell){
+				if (cell->is_artificial()) continue;
+				const int region = cellRegionSet[i][cell->active_cell_index()];
+				if ((region < 0) || (targetField.find(regionLabelSet[i][region]) != targetField.end())) continue;
+				cell->get_dof_indices(local_dof_indices);
+				keptDOFs.insert(local_dof_indices.begin(), local_dof_indices.end());
+			}
+
+			std::map<types::global_dof_index, unsigned int> movedDOFs;
+			for (typename DoFHandler<dim>::active_cell_iterator cell=dofHandlersSet[fieldIndex]->begin_active(); cell!=dofHandlersSet[fieldIndex]->end(); ++cell){
+				if (cell->is_artificial()) continue;
+				const double target = labels(labelDoF[cell->active_cell_index()]);
+				if (target < 0.0) continue;
+				cell->get_dof_indices(local_dof_indices);
+				for (unsigned int k=0; k<local_dof_indices.size(); k++){
+					if (U.in_local_range(local_dof_indices[k]) && (keptDOFs.count(local_dof_indices[k]) == 0)){
+						movedDOFs[local_dof_indices[k]] = (unsigned int) target;
+					}
+				}
+			}
+
+			// The fields share the DOF numbering, since they have the same finite element and mesh
+			for (typename std::map<types::global_dof_index, unsigned int>::const_iterator it=movedDOFs.begin(); it!=movedDOFs.end(); ++it){
+				(*solutionSet[it->second])(it->first) += U(it->first);
+				U(it->first) = 0.0;
+				fieldChanged[it->second] = true;
+			}
+			fieldChanged[fieldIndex] = true;
+		}
+
+		for (unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+			if (!fieldChanged[fieldIndex]) continue;
+			constraintsOtherSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
+			constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
+			solutionSet[fieldIndex]->update_ghost_values();
+		}
+
+		// The bulk of the fields changed, so the active region has to be found again
+		activeCellBatchSet.clear();
+	}
+
+	if ((n_remapped > 0) || (n_unresolved > 0) || (currentIncrement%skipPrintSteps==0)){
+		char buffer[200];
+		sprintf(buffer, "grain remapping: %u grains in %u fields, %u grains remapped, %u pairs of grains too close without a free field\n", \
+				(unsigned int) grains.size(), (unsigned int) remapping_fields.size(), n_remapped, n_unresolved);
+		pcout << buffer;
+	}
+
+	computing_timer.exit_section("matrixFreePDE: grainRemapping");
+}
+
+#endif
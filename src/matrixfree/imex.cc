@@ -0,0 +1,163 @@
+//semi-implicit (IMEX) time stepping methods for MatrixFreePDE class
+
+#ifndef IMEX_MATRIXFREE_H
+#define IMEX_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//The fields listed in imexFields are advanced with the IMEX Euler scheme (M + timeStep*L)(u^{n+1}-u^n) = R(u^n) - M u^n,
+//where M is the lumped mass matrix, R(u^n) - M u^n is the explicit increment computed by getRHS and L is the stiff linear
+//operator given by getLHS. For a field with a coupled field (e.g. "c:mu" for a split Cahn-Hilliard equation) the operator is
+//the composition L = L_u invM L_w, where L_w is the LHS of the coupled field with respect to u and L_u the LHS of the field
+//with respect to the coupled field, both computed by getLHSBlock. The coupled field is updated explicitly from u^n before the
+//implicit solve.
+
+//parse imexFields and allocate the vectors needed by the IMEX solves
+template <int dim>
+void MatrixFreePDE<dim>::setupIMEXFields(){
+	if (imexCoupledFieldSet.size() != fields.size()){
+		isIMEXField.assign(fields.size(), false);
+		isIMEXCoupledField.assign(fields.size(), false);
+		imexCoupledFieldSet.assign(fields.size(), -1);
+
+		std::stringstream imexFieldNames(imexFields);
+		std::string entry;
+		while (std::getline(imexFieldNames, entry, ',')){
+			entry.erase(0, entry.find_first_not_of(" "));
+			entry.erase(entry.find_last_not_of(" ")+1);
+			if (entry.empty()) continue;
+
+			std::string coupledName;
+			if (entry.find(':') != std::string::npos){
+				coupledName = entry.substr(entry.find(':')+1);
+				entry = entry.substr(0, entry.find(':'));
+			}
+			unsigned int fieldIndex = getFieldIndex(entry);
+			if ((fields[fieldIndex].pdetype != PARABOLIC) || (fields[fieldIndex].type != SCALAR)){
+				pcout << "\nError: the IMEX field '" << entry << "' must be a PARABOLIC SCALAR field.\n\n";
+				exit(-1);
+			}
+			isIMEXField[fieldIndex] = true;
+
+			if (!coupledName.empty()){
+				unsigned int coupledIndex = getFieldIndex(coupledName);
+				if ((fields[coupledIndex].pdetype != PARABOLIC) || (fields[coupledIndex].type != SCALAR)){
+					pcout << "\nError: the IMEX coupled field '" << coupledName << "' must be a PARABOLIC SCALAR field.\n\n";
+					exit(-1);
+				}
+				imexCoupledFieldSet[fieldIndex] = coupledIndex;
+				isIMEXCoupledField[coupledIndex] = true;
+			}
+		}
+	}
+
+	imexScratchSet.resize(fields.size());
+	imexIncrementSet.resize(fields.size());
+	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		if (!isIMEXField[fieldIndex]) continue;
+		matrixFreeObject.initialize_dof_vector(vmultScratchSet[fieldIndex], fieldIndex);
+		matrixFreeObject.initialize_dof_vector(imexScratchSet[fieldIndex], (imexCoupledFieldSet[fieldIndex] >= 0 ? imexCoupledFieldSet[fieldIndex] : fieldIndex));
+		matrixFreeObject.initialize_dof_vector(imexIncrementSet[fieldIndex], fieldIndex);
+	}
+}
+
+//apply the IMEX operator (M + timeStep*L) of the field given by currentFieldIndex
+template <int dim>
+void MatrixFreePDE<dim>::vmultIMEX (vectorType &dst, const vectorType &src) const{
+	typedef std_cxx11::function<void (const MatrixFree<dim,numberType> &, vectorType &, const vectorType &,
+			const std::pair<unsigned int,unsigned int> &)> cellOperation;
+	const unsigned int fieldIndex = currentFieldIndex;
+	const int coupledIndex = imexCoupledFieldSet[fieldIndex];
+	const unsigned int invM_size = invM.local_size();
+
+	// z = invM*L_w*src
+	const vectorType *implicitSrc = &src;
+	unsigned int implicitSrcIndex = fieldIndex;
+	if (coupledIndex >= 0){
+		vectorType &z = imexScratchSet[fieldIndex];
+		z = 0.0;
+		matrixFreeObject.cell_loop (cellOperation(std_cxx11::bind(&MatrixFreePDE<dim>::getLHSBlock, this, std_cxx11::_1, std_cxx11::_2,
+				std_cxx11::_3, std_cxx11::_4, (unsigned int) coupledIndex, fieldIndex)), z, src);
+		z.compress(VectorOperation::add);
+		for (unsigned int dof=0; dof<invM_size; ++dof){
+			z.local_element(dof) *= invM.local_element(dof);
+		}
+		constraintsOtherSet[coupledIndex]->distribute(z);
+		implicitSrc = &z;
+		implicitSrcIndex = coupledIndex;
+	}
+
+	// dst = M*src + L_u*z
+	matrixFreeObject.cell_loop (cellOperation(std_cxx11::bind(&MatrixFreePDE<dim>::getLHSBlock, this, std_cxx11::_1, std_cxx11::_2,
+			std_cxx11::_3, std_cxx11::_4, fieldIndex, implicitSrcIndex)), dst, *implicitSrc);
+	dst.compress(VectorOperation::add);
+	for (unsigned int dof=0; dof<invM_size; ++dof){
+		if (invM.local_element(dof) != 0.0){
+			dst.local_element(dof) += src.local_element(dof)/invM.local_element(dof);
+		}
+	}
+}
+
+//IMEX update of a field, the residual of the field has to be computed for the current solution
+template <int dim>
+void MatrixFreePDE<dim>::solveIMEXIncrement(unsigned int fieldIndex){
+	char buffer[200];
+	vectorType &U = *solutionSet[fieldIndex];
+	vectorType &R = *residualSet[fieldIndex];
+	vectorType &dU = imexIncrementSet[fieldIndex];
+	const unsigned int invM_size = invM.local_size();
+
+	// Explicit increment R - M*U, zero for the constrained and Dirichlet DOFs
+	for (unsigned int dof=0; dof<invM_size; ++dof){
+		if (invM.local_element(dof) != 0.0){
+			R.local_element(dof) -= U.local_element(dof)/invM.local_element(dof);
+		}
+		else {
+			R.local_element(dof) = 0.0;
+		}
+	}
+	for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+		R.local_element(dirichletLocalIndicesSet[fieldIndex][i]) = 0.0;
+	}
+
+	// Solve with the previous increment as the initial guess, preconditioned by the inverse lumped mass matrix
+	currentFieldIndex = fieldIndex; // Used in vmult()
+	SolverControl solver_control(maxSolverIterations, imexSolverTolerance*R.l2_norm());
+	SolverCG<vectorType> solver(solver_control);
+	DiagonalMatrix<vectorType> preconditioner;
+	preconditioner.reinit(invM);
+	for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+		dU.local_element(dirichletLocalIndicesSet[fieldIndex][i]) = 0.0;
+	}
+	cacheLHSFields(fieldIndex);
+	if (imexCoupledFieldSet[fieldIndex] >= 0){
+		cacheLHSFields(imexCoupledFieldSet[fieldIndex]);
+	}
+	try{
+		solver.solve(*this, dU, R, preconditioner);
+	}
+	catch (...) {
+		pcout << "\nWarning: IMEX solver did not converge as per set tolerances. consider increasing maxSolverIterations or imexSolverTolerance.\n";
+	}
+	clearLHSFieldCache();
+
+	// Add the increment, checking the updated values in the same pass
+	for (unsigned int dof=0; dof<U.local_size(); ++dof){
+		U.local_element(dof) += dU.local_element(dof);
+		solutionCheck += U.local_element(dof)-U.local_element(dof);
+	}
+
+	// Apply hanging node and periodic constraints
+	constraintsOtherSet[fieldIndex]->distribute(U);
+	//sync ghost DOF's
+	U.update_ghost_values();
+
+	if (currentIncrement%skipPrintSteps==0){
+		sprintf(buffer, "field '%2s' [IMEX solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, solution: %12.6e, dU: %12.6e\n", \
+				fields[fieldIndex].name.c_str(), R.l2_norm(), solver_control.last_value(), solver_control.last_step(), \
+				U.l2_norm(), dU.l2_norm());
+		pcout << buffer;
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+//initial guess methods for the implicit solves of the MatrixFreePDE class
+
+#ifndef IMPLICITINITIALGUESS_MATRIXFREE_H
+#define IMPLICITINITIALGUESS_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//set the initial guess for the increment of an elliptic field
+template <int dim>
+void MatrixFreePDE<dim>::getImplicitInitialGuess(unsigned int fieldIndex, vectorType &dU, const vectorType &R){
+	std::string initial_guess_type = implicitInitialGuess;
+
+	if (dUHistorySet.size() != fields.size()){
+		dUHistorySet.resize(fields.size());
+		recycledBasisSet.resize(fields.size());
+		recycledBasisLHSSet.resize(fields.size());
+	}
+
+	dU=0.0;
+	if (initial_guess_type == "ZERO"){
+		return;
+	}
+	else if (initial_guess_type == "LINEAR"){
+		// Linear extrapolation of the solution, i.e. the last increment
+		if (dUHistorySet[fieldIndex].size() > 0){
+			dU=dUHistorySet[fieldIndex][0];
+		}
+	}
+	else if (initial_guess_type == "QUADRATIC"){
+		// Quadratic extrapolation of the solution, i.e. a linear extrapolation of the last two increments
+		if (dUHistorySet[fieldIndex].size() > 1){
+			dU.equ(2.0, dUHistorySet[fieldIndex][0]);
+			dU.add(-1.0, dUHistorySet[fieldIndex][1]);
+		}
+		else if (dUHistorySet[fieldIndex].size() > 0){
+			dU=dUHistorySet[fieldIndex][0];
+		}
+	}
+	else if (initial_guess_type == "PROJECTION"){
+		// Galerkin projection of the solution onto the recycled subspace. The basis is A-orthonormal, so the
+		// projection is the sum of the basis vectors weighted by their product with R.
+		for (unsigned int i=0; i<recycledBasisSet[fieldIndex].size(); i++){
+			dU.add(recycledBasisSet[fieldIndex][i]*R, recycledBasisSet[fieldIndex][i]);
+		}
+	}
+	else {
+		pcout << "\nError: unknown implicitInitialGuess '" << initial_guess_type << "'. Valid options are ZERO, LINEAR, QUADRATIC and PROJECTION.\n\n";
+		exit(-1);
+	}
+
+	// The Dirichlet DOFs are identity rows of the LHS, so their increment is known exactly
+	for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+		dU.local_element(dirichletLocalIndicesSet[fieldIndex][i]) = R.local_element(dirichletLocalIndicesSet[fieldIndex][i]);
+	}
+}
+
+//store the increment of an elliptic field for the following initial guesses
+template <int dim>
+void MatrixFreePDE<dim>::storeImplicitIncrement(unsigned int fieldIndex, const vectorType &dU){
+	std::string initial_guess_type = implicitInitialGuess;
+
+	if ((initial_guess_type == "LINEAR") || (initial_guess_type == "QUADRATIC")){
+		std::vector<vectorType> &history = dUHistorySet[fieldIndex];
+		const unsigned int historySize = (initial_guess_type == "LINEAR" ? 1 : 2);
+		history.insert(history.begin(), dU);
+		if (history.size() > historySize){
+			history.pop_back();
+		}
+	}
+	else if (initial_guess_type == "PROJECTION"){
+		std::vector<vectorType> &basis = recycledBasisSet[fieldIndex];
+		std::vector<vectorType> &basisLHS = recycledBasisLHSSet[fieldIndex];
+
+		// A-orthogonalize the increment against the current basis (modified Gram-Schmidt)
+		vectorType v(dU), Av;
+		Av.reinit(dU);
+		vmult(Av, dU);
+		const double dU_norm = dU*Av;
+		for (unsigned int i=0; i<basis.size(); i++){
+			const double c = basisLHS[i]*v;
+			v.add(-c, basis[i]);
+			Av.add(-c, basisLHS[i]);
+		}
+		const double v_norm = v*Av;
+
+		// Skip increments that are (numerically) already in the subspace
+		if ((v_norm > 1.0e-12*dU_norm) && (v_norm > 0.0)){
+			v /= std::sqrt(v_norm);
+			Av /= std::sqrt(v_norm);
+			if (basis.size() >= initialGuessSubspaceSize){
+				basis.erase(basis.begin());
+				basisLHS.erase(basisLHS.begin());
+			}
+			basis.push_back(v);
+			basisLHS.push_back(Av);
+		}
+	}
+}
+
+//discard the stored increments of an elliptic field, so that an increment of an unconverged solve does not enter the following initial guesses
+template <int dim>
+void MatrixFreePDE<dim>::resetImplicitIncrements(unsigned int fieldIndex){
+	if (fieldIndex < dUHistorySet.size()){
+		dUHistorySet[fieldIndex].clear();
+		recycledBasisSet[fieldIndex].clear();
+		recycledBasisLHSSet[fieldIndex].clear();
+	}
+}
+
+#endif
@@ -39,6 +39,13 @@
 	 // Do the initial global refinement
 	 triangulation.refine_global (refineFactor);
 
+	 // Weight the cells by their modeled cost when the mesh is repartitioned after adaptive refinement
+	 #if hAdaptivity==true
+	 if (weightedRepartitioning){
+		 triangulation.signals.cell_weight.connect(std_cxx11::bind(&MatrixFreePDE<dim>::cellWeight, this, std_cxx11::_1, std_cxx11::_2));
+	 }
+	 #endif
+
 	 // Write out the size of the computational domain and the total number of elements
 	 pcout << "problem dimensions: " << spanX << "x" << spanY << "x" << spanZ << std::endl;
 	 pcout << "number of elements: " << triangulation.n_global_active_cells() << std::endl;
@@ -68,6 +75,12 @@
 		 else if (it->pdetype==ELLIPTIC){
 			 isEllipticBVP=true;
 			 ellipticFieldIndex=it->index;
+			 // The LHS operator of the implicit solves shares the number type of the cell kernels, and a single precision
+			 // operator would limit the accuracy of the solves
+			 if (singlePrecisionRHS){
+				 pcout << "\nmatrixFreePDE.h: singlePrecisionRHS is not supported for ELLIPTIC fields (field '" << it->name << "')\n";
+				 exit(-1);
+			 }
 		 }
 
 		 //create FESystem
@@ -93,6 +106,9 @@
 		 dofHandlersSet_nonconst.push_back(dof_handler);
 
 		 dof_handler->distribute_dofs (*fe);
+		 if (isMultigridPreconditioned){
+			 dof_handler->distribute_mg_dofs (*fe);
+		 }
 		 totalDOFs+=dof_handler->n_dofs();
 
 		 // Extract locally_relevant_dofs
@@ -112,7 +128,8 @@
 		 constraintsDirichletSet_nonconst.push_back(constraintsDirichlet);
 		 constraintsOther=new ConstraintMatrix; constraintsOtherSet.push_back(constraintsOther);
 		 constraintsOtherSet_nonconst.push_back(constraintsOther);
-		 valuesDirichletSet.push_back(new std::map<dealii::types::global_dof_index, double>);
+		 dirichletLocalIndicesSet.push_back(std::vector<unsigned int>());
+		 dirichletLocalValuesSet.push_back(std::vector<double>());
 
 		 constraintsDirichlet->clear(); constraintsDirichlet->reinit(*locally_relevant_dofs);
 		 constraintsOther->clear(); constraintsOther->reinit(*locally_relevant_dofs);
@@ -134,15 +151,8 @@
 		 constraintsDirichlet->close();
 		 constraintsOther->close();
 
-		 // Store Dirichlet BC DOF's
-		 valuesDirichletSet[it->index]->clear();
-		 for (types::global_dof_index i=0; i<dof_handler->n_dofs(); i++){
-			 if (locally_relevant_dofs->is_element(i)){
-				 if (constraintsDirichlet->is_constrained(i)){
-					 (*valuesDirichletSet[it->index])[i] = constraintsDirichlet->get_inhomogeneity(i);
-				 }
-			 }
-		 }
+		 // Store the locally owned Dirichlet BC DOF's
+		 storeDirichletDOFs(it->index);
 
 		 sprintf(buffer, "field '%2s' DOF : %u (Constraint DOF : %u)\n", \
 				 it->name.c_str(), dof_handler->n_dofs(), constraintsDirichlet->n_constraints());
@@ -151,19 +161,32 @@
 	 pcout << "total DOF : " << totalDOFs << std::endl;
 
 	 // Setup the matrix free object
-	 typename MatrixFree<dim,double>::AdditionalData additional_data;
+	 typename MatrixFree<dim,numberType>::AdditionalData additional_data;
 	 additional_data.mpi_communicator = MPI_COMM_WORLD;
-	 additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+	 additional_data.tasks_parallel_scheme = MatrixFree<dim,numberType>::AdditionalData::partition_partition;
 	 additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
 	 QGaussLobatto<1> quadrature (finiteElementDegree+1);
 	 matrixFreeObject.clear();
+	 #if hAdaptivity==true
+	 // Gauss-Lobatto points for the cell kernels (quadrature index 0) and Gauss points for the refinement criterion (quadrature index 1)
+	 std::vector<Quadrature<1> > quadratures;
+	 quadratures.push_back(quadrature);
+	 quadratures.push_back(QGauss<1>(finiteElementDegree+1));
+	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadratures, additional_data);
+	 #else
 	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadrature, additional_data);
+	 #endif
+
+	 // Setup the level matrix free objects and transfer operators of the multigrid preconditioner
+	 setupMultigrid();
 
 	 bool dU_scalar_init = false;
 	 bool dU_vector_init = false;
  
 	 // Setup solution vectors
 	 pcout << "initializing parallel::distributed residual and solution vectors\n";
+	 vmultScratchSet.resize(fields.size());
+	 mixedPrecisionScratchSet.resize(fields.size());
 	 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
 		 vectorType *U, *R;
 
@@ -176,6 +199,10 @@
 		 // Initializing temporary dU vector required for implicit solves of the elliptic equation.
 		 // Assuming here that there is only one elliptic field in the problem (the main problem is if one is a scalar and the other is a vector, because then dU would need to be different sizes)
 		 if (fields[fieldIndex].pdetype==ELLIPTIC){
+			 matrixFreeObject.initialize_dof_vector(vmultScratchSet[fieldIndex],  fieldIndex);
+			 if (mixedPrecisionEllipticSolves){
+				 initializeMixedPrecisionScratch(fieldIndex);
+			 }
 			 if (fields[fieldIndex].type == SCALAR){
 				 if (dU_scalar_init == false){
 					 matrixFreeObject.initialize_dof_vector(dU_scalar,  fieldIndex);
@@ -190,6 +217,9 @@
 			 }
 		 }
 	 }
+
+	 // Parse the IMEX fields and allocate their vectors
+	 setupIMEXFields();
    
 	 //check if time dependent BVP and compute invM
 	 if (isTimeDependentBVP){
@@ -214,6 +244,12 @@
 		 solutionSet[fieldIndex]->update_ghost_values();
 	 }
 
+	 // Compute the LHS diagonal used by the JACOBI and CHEBYSHEV preconditioners
+	 computeLHSDiagonal();
+
+	 // Build the multigrid preconditioners of the elliptic fields
+	 updateMultigrid();
+
 	 // Check and perform adaptive mesh refinement, which reinitializes the system with the new mesh
 	 adaptiveRefine(0);
 
@@ -55,9 +55,9 @@
    constraintsOther->close();
 
    //setup the matrix free object
-   typename MatrixFree<dim,double>::AdditionalData additional_data;
+   typename MatrixFree<dim,numberType>::AdditionalData additional_data;
    additional_data.mpi_communicator = MPI_COMM_WORLD;
-   additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+   additional_data.tasks_parallel_scheme = MatrixFree<dim,numberType>::AdditionalData::partition_partition;
    additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
    QGaussLobatto<1> quadrature (finiteElementDegree+1);
    num_quadrature_points=std::pow(quadrature.size(),dim);
@@ -31,8 +31,8 @@ void MatrixFreePDE<dim>::computeInvM(){
   
 	//select gauss lobatto quadrature points which are suboptimal but give diagonal M
 	if (fields[parabolicFieldIndex].type==SCALAR){
-		VectorizedArray<double> one = make_vectorized_array (1.0);
-		FEEvaluation<dim,finiteElementDegree> fe_eval(matrixFreeObject, parabolicFieldIndex);
+		scalarType one = constV(1.0);
+		FEEvaluation<dim,finiteElementDegree,finiteElementDegree+1,1,numberType> fe_eval(matrixFreeObject, parabolicFieldIndex);
 		const unsigned int n_q_points = fe_eval.n_q_points;
 		for (unsigned int cell=0; cell<matrixFreeObject.n_macro_cells(); ++cell){
 			fe_eval.reinit(cell);
@@ -49,7 +49,7 @@ void MatrixFreePDE<dim>::computeInvM(){
 			oneV[i] = 1.0;
 		}
 
-		FEEvaluation<dim,finiteElementDegree,finiteElementDegree+1,dim> fe_eval(matrixFreeObject, parabolicFieldIndex);
+		FEEvaluation<dim,finiteElementDegree,finiteElementDegree+1,dim,numberType> fe_eval(matrixFreeObject, parabolicFieldIndex);
 
 		const unsigned int n_q_points = fe_eval.n_q_points;
 		for (unsigned int cell=0; cell<matrixFreeObject.n_macro_cells(); ++cell){
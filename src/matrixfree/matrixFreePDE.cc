@@ -10,7 +10,13 @@
  MatrixFreePDE<dim>::MatrixFreePDE ()
  :
  Subscriptor(),
- triangulation (MPI_COMM_WORLD),
+ triangulation (MPI_COMM_WORLD,
+		 (std::string(preconditionerType)=="MULTIGRID" ? Triangulation<dim>::limit_level_difference_at_vertices : Triangulation<dim>::none),
+		 (std::string(preconditionerType)=="MULTIGRID" ? parallel::distributed::Triangulation<dim>::construct_multigrid_hierarchy : parallel::distributed::Triangulation<dim>::default_setting)),
+ solutionCheck(0.0),
+ skippedRemeshings(0),
+ refineFlagsSet(false),
+ isMultigridPreconditioned(std::string(preconditionerType)=="MULTIGRID"),
  isTimeDependentBVP(false),
  isEllipticBVP(false),
  dtValue(0.0),
@@ -28,6 +34,19 @@
  template <int dim>
  MatrixFreePDE<dim>::~MatrixFreePDE ()
  {
+   clearMultigrid();
+   for(unsigned int iter=0; iter<chebyshevPreconditionerSet.size(); iter++){
+     delete chebyshevPreconditionerSet[iter];
+   }
+   for(unsigned int iter=0; iter<diagonalInverseSet.size(); iter++){
+     delete diagonalInverseSet[iter];
+   }
+   for(unsigned int iter=0; iter<chebyshevPreconditionerSinglePrecisionSet.size(); iter++){
+     delete chebyshevPreconditionerSinglePrecisionSet[iter];
+   }
+   for(unsigned int iter=0; iter<diagonalInverseSinglePrecisionSet.size(); iter++){
+     delete diagonalInverseSinglePrecisionSet[iter];
+   }
    matrixFreeObject.clear();
    for(unsigned int iter=0; iter<fields.size(); iter++){
      delete soltransSet[iter];
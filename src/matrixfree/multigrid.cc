@@ -0,0 +1,528 @@
+//geometric multigrid methods for MatrixFreePDE class
+
+#ifndef MULTIGRID_MATRIXFREE_H
+#define MULTIGRID_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//wrapper exposing the LHS operator on one level of the mesh hierarchy with the
+//matrix interface expected by the deal.II multigrid classes
+template <int dim>
+class mgLevelMatrix : public Subscriptor
+{
+ public:
+  mgLevelMatrix(): pde(NULL), level(0) {}
+
+  void initialize(const MatrixFreePDE<dim> &_pde, const unsigned int _level){
+    pde=&_pde;
+    level=_level;
+  }
+
+  void vmult(vectorType &dst, const vectorType &src) const{
+    pde->vmultLevel(level, dst, src);
+  }
+
+  //the LHS operator of the elliptic fields is symmetric
+  void Tvmult(vectorType &dst, const vectorType &src) const{
+    vmult(dst, src);
+  }
+
+  void vmult_add(vectorType &dst, const vectorType &src) const{
+    if (!scratch.partitioners_are_compatible(*dst.get_partitioner())){
+      scratch.reinit(dst, true);
+    }
+    vmult(scratch, src);
+    dst+=scratch;
+  }
+
+  void Tvmult_add(vectorType &dst, const vectorType &src) const{
+    vmult_add(dst, src);
+  }
+
+  types::global_dof_index m() const{
+    return pde->levelSize(level);
+  }
+
+  types::global_dof_index n() const{
+    return pde->levelSize(level);
+  }
+
+  void initialize_dof_vector(vectorType &vec) const{
+    pde->initializeLevelVector(level, vec);
+  }
+
+  //the level diagonals are passed to the smoothers explicitly
+  double el(const types::global_dof_index i, const types::global_dof_index j) const{
+    AssertThrow(false, ExcNotImplemented());
+    return 0.0;
+  }
+
+ private:
+  const MatrixFreePDE<dim> *pde;
+  unsigned int level;
+  //temporary vector of the _add operations, allocated on their first call
+  mutable vectorType scratch;
+};
+
+//wrapper exposing the coupling across the refinement edges of a level (vmult)
+//and its transpose (Tvmult), used as the edge matrices of the multigrid cycle
+template <int dim>
+class mgInterfaceMatrix : public Subscriptor
+{
+ public:
+  mgInterfaceMatrix(): pde(NULL), level(0) {}
+
+  void initialize(const MatrixFreePDE<dim> &_pde, const unsigned int _level){
+    pde=&_pde;
+    level=_level;
+  }
+
+  void vmult(vectorType &dst, const vectorType &src) const{
+    pde->vmultLevelInterface(level, dst, src, false);
+  }
+
+  void Tvmult(vectorType &dst, const vectorType &src) const{
+    pde->vmultLevelInterface(level, dst, src, true);
+  }
+
+  void vmult_add(vectorType &dst, const vectorType &src) const{
+    if (!scratch.partitioners_are_compatible(*dst.get_partitioner())){
+      scratch.reinit(dst, true);
+    }
+    vmult(scratch, src);
+    dst+=scratch;
+  }
+
+  void Tvmult_add(vectorType &dst, const vectorType &src) const{
+    if (!scratch.partitioners_are_compatible(*dst.get_partitioner())){
+      scratch.reinit(dst, true);
+    }
+    Tvmult(scratch, src);
+    dst+=scratch;
+  }
+
+  types::global_dof_index m() const{
+    return pde->levelSize(level);
+  }
+
+  types::global_dof_index n() const{
+    return pde->levelSize(level);
+  }
+
+  void initialize_dof_vector(vectorType &vec) const{
+    pde->initializeLevelVector(level, vec);
+  }
+
+  //the level diagonals are passed to the smoothers explicitly
+  double el(const types::global_dof_index i, const types::global_dof_index j) const{
+    AssertThrow(false, ExcNotImplemented());
+    return 0.0;
+  }
+
+ private:
+  const MatrixFreePDE<dim> *pde;
+  unsigned int level;
+  //temporary vector of the _add operations, allocated on their first call
+  mutable vectorType scratch;
+};
+
+#if DEAL_II_VERSION_GTE(8,5,0)
+//multigrid preconditioner of one elliptic field: the level and refinement edge operators, the Chebyshev smoothers (the one on the
+//coarsest level is used as the coarse solver) and the V-cycle. It is built by updateMultigrid() and reused by the solves of the field.
+template <int dim>
+class mgPreconditioner
+{
+ public:
+  typedef PreconditionChebyshev<mgLevelMatrix<dim>, vectorType> smootherType;
+
+  mgPreconditioner(): multigrid(NULL), preconditioner(NULL) {}
+
+  ~mgPreconditioner(){
+    delete preconditioner;
+    delete multigrid;
+  }
+
+  void initialize(const MatrixFreePDE<dim> &pde, const DoFHandler<dim> &dof_handler, const MGTransferMatrixFree<dim,double> &transfer,
+		  const std::vector<vectorType> &levelDiagonalInverse){
+    const unsigned int nLevels=levelDiagonalInverse.size();
+    levelMatrices.resize(0, nLevels-1);
+    interfaceMatrices.resize(0, nLevels-1);
+    for (unsigned int level=0; level<nLevels; level++){
+      levelMatrices[level].initialize(pde, level);
+      interfaceMatrices[level].initialize(pde, level);
+    }
+
+    MGLevelObject<typename smootherType::AdditionalData> smootherData(0, nLevels-1);
+    for (unsigned int level=0; level<nLevels; level++){
+      if (level > 0){
+        smootherData[level].smoothing_range = multigridSmoothingRange;
+        smootherData[level].degree = multigridSmootherDegree;
+        smootherData[level].eig_cg_n_iterations = 10;
+      }
+      else {
+        smootherData[0].smoothing_range = 1e-3;
+        smootherData[0].degree = numbers::invalid_unsigned_int;
+        smootherData[0].eig_cg_n_iterations = levelMatrices[0].m();
+      }
+      smootherData[level].matrix_diagonal_inverse = levelDiagonalInverse[level];
+    }
+    smoother.initialize(levelMatrices, smootherData);
+    coarseSolver.initialize(smoother);
+
+    mgMatrix.initialize(levelMatrices);
+    mgInterface.initialize(interfaceMatrices);
+    multigrid=new Multigrid<vectorType>(dof_handler, mgMatrix, coarseSolver, transfer, smoother, smoother);
+    multigrid->set_edge_matrices(mgInterface, mgInterface);
+    preconditioner=new PreconditionMG<dim, vectorType, MGTransferMatrixFree<dim,double> >(dof_handler, *multigrid, transfer);
+  }
+
+  MGLevelObject<mgLevelMatrix<dim> > levelMatrices;
+  MGLevelObject<mgInterfaceMatrix<dim> > interfaceMatrices;
+  mg::SmootherRelaxation<smootherType, vectorType> smoother;
+  MGCoarseGridApplySmoother<vectorType> coarseSolver;
+  mg::Matrix<vectorType> mgMatrix, mgInterface;
+  Multigrid<vectorType> *multigrid;
+  PreconditionMG<dim, vectorType, MGTransferMatrixFree<dim,double> > *preconditioner;
+};
+#endif
+
+//setup the level DOFs, level matrix free objects and transfer operators
+template <int dim>
+void MatrixFreePDE<dim>::setupMultigrid(){
+  if (!isMultigridPreconditioned) return;
+
+  clearMultigrid();
+  const unsigned int nLevels=triangulation.n_global_levels();
+
+  //level matrix free objects (all the fields, no constraints as the Dirichlet
+  //and refinement edge DOFs are handled in vmultLevel)
+  ConstraintMatrix levelConstraints;
+  levelConstraints.close();
+  std::vector<const ConstraintMatrix*> levelConstraintsSet(fields.size(), &levelConstraints);
+  QGaussLobatto<1> quadrature (finiteElementDegree+1);
+  for (unsigned int level=0; level<nLevels; level++){
+    typename MatrixFree<dim,numberType>::AdditionalData additional_data;
+    additional_data.mpi_communicator = MPI_COMM_WORLD;
+    additional_data.tasks_parallel_scheme = MatrixFree<dim,numberType>::AdditionalData::partition_partition;
+    additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
+    additional_data.level_mg_handler = level;
+
+    MatrixFree<dim,numberType>* levelMatrixFree=new MatrixFree<dim,numberType>;
+    levelMatrixFree->reinit (dofHandlersSet, levelConstraintsSet, quadrature, additional_data);
+    mgMatrixFreeSet.push_back(levelMatrixFree);
+
+    std::vector<vectorType*> levelSolutions;
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+      vectorType *U=new vectorType;
+      levelMatrixFree->initialize_dof_vector(*U, fieldIndex); *U=0;
+      levelSolutions.push_back(U);
+    }
+    mgSolutionSet.push_back(levelSolutions);
+  }
+
+  //level constraints and transfer operators for the elliptic fields
+  mgDirichletIndicesSet.resize(fields.size());
+  mgEdgeIndicesSet.resize(fields.size());
+  mgConstrainedDoFsSet.resize(fields.size(), NULL);
+#if DEAL_II_VERSION_GTE(8,5,0)
+  mgTransferSet.resize(fields.size(), NULL);
+#endif
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+    if (fields[fieldIndex].pdetype!=ELLIPTIC) continue;
+    currentFieldIndex=fieldIndex;
+
+    MGConstrainedDoFs* constrainedDoFs=new MGConstrainedDoFs;
+    constrainedDoFs->initialize(*dofHandlersSet[fieldIndex]);
+    mgConstrainedDoFsSet[fieldIndex]=constrainedDoFs;
+
+    std::vector<IndexSet> levelDirichletIndices(nLevels);
+    for (unsigned int level=0; level<nLevels; level++){
+      levelDirichletIndices[level].set_size(dofHandlersSet[fieldIndex]->n_dofs(level));
+    }
+    getLevelDirichletIndices(levelDirichletIndices);
+
+    //store the locally owned constrained DOFs as local indices of the level vectors
+    mgDirichletIndicesSet[fieldIndex].resize(nLevels);
+    mgEdgeIndicesSet[fieldIndex].resize(nLevels);
+    for (unsigned int level=0; level<nLevels; level++){
+      const IndexSet &owned=dofHandlersSet[fieldIndex]->locally_owned_mg_dofs(level);
+      const IndexSet &edge=constrainedDoFs->get_refinement_edge_indices(level);
+      for (IndexSet::ElementIterator it=levelDirichletIndices[level].begin(); it!=levelDirichletIndices[level].end(); ++it){
+        if (owned.is_element(*it)){
+          mgDirichletIndicesSet[fieldIndex][level].push_back(owned.index_within_set(*it));
+        }
+      }
+      for (IndexSet::ElementIterator it=edge.begin(); it!=edge.end(); ++it){
+        if (owned.is_element(*it)){
+          mgEdgeIndicesSet[fieldIndex][level].push_back(owned.index_within_set(*it));
+        }
+      }
+    }
+
+#if DEAL_II_VERSION_GTE(8,5,0)
+    MGTransferMatrixFree<dim,double>* transfer=new MGTransferMatrixFree<dim,double>;
+    transfer->initialize_constraints(*constrainedDoFs);
+    transfer->build(*dofHandlersSet[fieldIndex]);
+    mgTransferSet[fieldIndex]=transfer;
+#endif
+  }
+}
+
+//update the level copies of the fields, the level diagonals of the LHS operator and the multigrid preconditioner of each elliptic field
+template <int dim>
+void MatrixFreePDE<dim>::updateMultigrid(){
+  if (!isMultigridPreconditioned) return;
+
+  //log time
+  computing_timer.enter_section("matrixFreePDE: updateMultigrid");
+  const unsigned int nLevels=mgMatrixFreeSet.size();
+
+  //interpolate the fields onto the levels, from the finest level down to the
+  //coarsest (active level cells take the values of the active mesh, the others
+  //are interpolated from their children)
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+    const DoFHandler<dim> &dof_handler=*dofHandlersSet[fieldIndex];
+    const FiniteElement<dim> &fe=dof_handler.get_fe();
+    const unsigned int dofs_per_cell=fe.dofs_per_cell;
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+    Vector<double> local_values(dofs_per_cell), child_values(dofs_per_cell), tmp(dofs_per_cell);
+
+    std::vector<vectorType> levelValues(nLevels);
+    for (int level=nLevels-1; level>=0; level--){
+      IndexSet relevant_level_dofs;
+      DoFTools::extract_locally_relevant_level_dofs(dof_handler, level, relevant_level_dofs);
+      levelValues[level].reinit(dof_handler.locally_owned_mg_dofs(level), relevant_level_dofs, MPI_COMM_WORLD);
+
+      for (typename DoFHandler<dim>::cell_iterator cell=dof_handler.begin(level); cell!=dof_handler.end(level); ++cell){
+        if (cell->level_subdomain_id()!=triangulation.locally_owned_subdomain()) continue;
+
+        if (cell->active()){
+          cell->get_dof_values(*solutionSet[fieldIndex], local_values);
+        }
+        else{
+          local_values=0.0;
+          for (unsigned int child=0; child<cell->n_children(); child++){
+            cell->child(child)->get_mg_dof_indices(dof_indices);
+            for (unsigned int i=0; i<dofs_per_cell; i++){
+              child_values(i)=levelValues[level+1](dof_indices[i]);
+            }
+            fe.get_restriction_matrix(child, cell->refinement_case()).vmult(tmp, child_values);
+            for (unsigned int i=0; i<dofs_per_cell; i++){
+              if (fe.restriction_is_additive(i)){
+                local_values(i)+=tmp(i);
+              }
+              else if (tmp(i)!=0.0){
+                local_values(i)=tmp(i);
+              }
+            }
+          }
+        }
+
+        cell->get_mg_dof_indices(dof_indices);
+        for (unsigned int i=0; i<dofs_per_cell; i++){
+          levelValues[level](dof_indices[i])=local_values(i);
+        }
+      }
+      levelValues[level].compress(VectorOperation::insert);
+      levelValues[level].update_ghost_values();
+
+      //copy to the layout of the level matrix free object
+      vectorType &U=*mgSolutionSet[level][fieldIndex];
+      for (unsigned int dof=0; dof<U.local_size(); ++dof){
+        U.local_element(dof)=levelValues[level].local_element(dof);
+      }
+      U.update_ghost_values();
+    }
+  }
+
+  //compute the inverse of the level diagonals (constrained DOFs have unit diagonal) and build the preconditioners
+  mgDiagonalInverseSet.resize(fields.size());
+  mgSrcScratchSet.resize(fields.size());
+  mgDstScratchSet.resize(fields.size());
+#if DEAL_II_VERSION_GTE(8,5,0)
+  mgPreconditionerSet.resize(fields.size(), NULL);
+#endif
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+    if (fields[fieldIndex].pdetype!=ELLIPTIC) continue;
+    currentFieldIndex=fieldIndex; // Used in getLHSDiagonal() and the level operators
+
+    mgDiagonalInverseSet[fieldIndex].resize(nLevels);
+    mgSrcScratchSet[fieldIndex].resize(nLevels);
+    mgDstScratchSet[fieldIndex].resize(nLevels);
+    for (unsigned int level=0; level<nLevels; level++){
+      mgMatrixFreeSet[level]->initialize_dof_vector(mgSrcScratchSet[fieldIndex][level], fieldIndex);
+      mgMatrixFreeSet[level]->initialize_dof_vector(mgDstScratchSet[fieldIndex][level], fieldIndex);
+      mgMatrixFreeSet[level]->initialize_dof_vector(mgDiagonalInverseSet[fieldIndex][level], fieldIndex);
+
+      vectorType &diagonal=mgDiagonalInverseSet[fieldIndex][level];
+      mgMatrixFreeSet[level]->cell_loop (&MatrixFreePDE<dim>::getLHSDiagonal, this, diagonal, mgSrcScratchSet[fieldIndex][level]);
+      diagonal.compress(VectorOperation::add);
+
+      for (unsigned int i=0; i<mgDirichletIndicesSet[fieldIndex][level].size(); i++){
+        diagonal.local_element(mgDirichletIndicesSet[fieldIndex][level][i])=1.0;
+      }
+      for (unsigned int i=0; i<mgEdgeIndicesSet[fieldIndex][level].size(); i++){
+        diagonal.local_element(mgEdgeIndicesSet[fieldIndex][level][i])=1.0;
+      }
+      for (unsigned int dof=0; dof<diagonal.local_size(); ++dof){
+        if (std::abs(diagonal.local_element(dof))>1.0e-15){
+          diagonal.local_element(dof)=1.0/diagonal.local_element(dof);
+        }
+        else{
+          diagonal.local_element(dof)=1.0;
+        }
+      }
+    }
+
+#if DEAL_II_VERSION_GTE(8,5,0)
+    //the eigenvalue estimates of the smoothers are done on the first solve and then reused
+    delete mgPreconditionerSet[fieldIndex];
+    mgPreconditionerSet[fieldIndex]=new mgPreconditioner<dim>;
+    mgPreconditionerSet[fieldIndex]->initialize(*this, *dofHandlersSet[fieldIndex], *mgTransferSet[fieldIndex], mgDiagonalInverseSet[fieldIndex]);
+#endif
+  }
+
+  //end log
+  computing_timer.exit_section("matrixFreePDE: updateMultigrid");
+}
+
+//delete the level data structures
+template <int dim>
+void MatrixFreePDE<dim>::clearMultigrid(){
+#if DEAL_II_VERSION_GTE(8,5,0)
+  for (unsigned int fieldIndex=0; fieldIndex<mgPreconditionerSet.size(); fieldIndex++){
+    delete mgPreconditionerSet[fieldIndex];
+  }
+  mgPreconditionerSet.clear();
+#endif
+  for (unsigned int level=0; level<mgMatrixFreeSet.size(); level++){
+    delete mgMatrixFreeSet[level];
+    for (unsigned int fieldIndex=0; fieldIndex<mgSolutionSet[level].size(); fieldIndex++){
+      delete mgSolutionSet[level][fieldIndex];
+    }
+  }
+  for (unsigned int fieldIndex=0; fieldIndex<mgConstrainedDoFsSet.size(); fieldIndex++){
+    delete mgConstrainedDoFsSet[fieldIndex];
+  }
+#if DEAL_II_VERSION_GTE(8,5,0)
+  for (unsigned int fieldIndex=0; fieldIndex<mgTransferSet.size(); fieldIndex++){
+    delete mgTransferSet[fieldIndex];
+  }
+  mgTransferSet.clear();
+#endif
+  mgMatrixFreeSet.clear();
+  mgSolutionSet.clear();
+  mgConstrainedDoFsSet.clear();
+  mgDirichletIndicesSet.clear();
+  mgEdgeIndicesSet.clear();
+  mgDiagonalInverseSet.clear();
+  mgSrcScratchSet.clear();
+  mgDstScratchSet.clear();
+}
+
+//default implementation of the level Dirichlet DOFs (none)
+template <int dim>
+void MatrixFreePDE<dim>::getLevelDirichletIndices(std::vector<IndexSet> &levelDirichletIndices){
+}
+
+//vmult operation for the LHS on a level of the mesh hierarchy
+template <int dim>
+void MatrixFreePDE<dim>::vmultLevel (const unsigned int level, vectorType &dst, const vectorType &src) const{
+  const std::vector<unsigned int> &dirichletIndices=mgDirichletIndicesSet[currentFieldIndex][level];
+  const std::vector<unsigned int> &edgeIndices=mgEdgeIndicesSet[currentFieldIndex][level];
+
+  //copy src into the layout of the level matrix free object, with zero constrained DOFs
+  vectorType &src2=mgSrcScratchSet[currentFieldIndex][level];
+  vectorType &dst2=mgDstScratchSet[currentFieldIndex][level];
+  for (unsigned int dof=0; dof<src.local_size(); ++dof){
+    src2.local_element(dof)=src.local_element(dof);
+  }
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    src2.local_element(dirichletIndices[i])=0.0;
+  }
+  for (unsigned int i=0; i<edgeIndices.size(); i++){
+    src2.local_element(edgeIndices[i])=0.0;
+  }
+
+  //call cell_loop
+  dst2=0.0;
+  mgMatrixFreeSet[level]->cell_loop (&MatrixFreePDE<dim>::getLHS, this, dst2, src2);
+  dst2.compress(VectorOperation::add);
+
+  //identity on the constrained DOFs
+  for (unsigned int dof=0; dof<dst.local_size(); ++dof){
+    dst.local_element(dof)=dst2.local_element(dof);
+  }
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    dst.local_element(dirichletIndices[i])=src.local_element(dirichletIndices[i]);
+  }
+  for (unsigned int i=0; i<edgeIndices.size(); i++){
+    dst.local_element(edgeIndices[i])=src.local_element(edgeIndices[i]);
+  }
+}
+
+//coupling between the refinement edge DOFs and the remaining DOFs of a level. The
+//plain product maps the interior DOFs to the edge DOFs and the transpose maps the
+//edge DOFs back to the interior DOFs.
+template <int dim>
+void MatrixFreePDE<dim>::vmultLevelInterface (const unsigned int level, vectorType &dst, const vectorType &src, const bool transpose) const{
+  const std::vector<unsigned int> &dirichletIndices=mgDirichletIndicesSet[currentFieldIndex][level];
+  const std::vector<unsigned int> &edgeIndices=mgEdgeIndicesSet[currentFieldIndex][level];
+
+  vectorType &src2=mgSrcScratchSet[currentFieldIndex][level];
+  vectorType &dst2=mgDstScratchSet[currentFieldIndex][level];
+  if (!transpose){
+    for (unsigned int dof=0; dof<src.local_size(); ++dof){
+      src2.local_element(dof)=src.local_element(dof);
+    }
+    for (unsigned int i=0; i<edgeIndices.size(); i++){
+      src2.local_element(edgeIndices[i])=0.0;
+    }
+  }
+  else{
+    src2=0.0;
+    for (unsigned int i=0; i<edgeIndices.size(); i++){
+      src2.local_element(edgeIndices[i])=src.local_element(edgeIndices[i]);
+    }
+  }
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    src2.local_element(dirichletIndices[i])=0.0;
+  }
+
+  //call cell_loop
+  dst2=0.0;
+  mgMatrixFreeSet[level]->cell_loop (&MatrixFreePDE<dim>::getLHS, this, dst2, src2);
+  dst2.compress(VectorOperation::add);
+
+  if (!transpose){
+    dst=0.0;
+    for (unsigned int i=0; i<edgeIndices.size(); i++){
+      dst.local_element(edgeIndices[i])=dst2.local_element(edgeIndices[i]);
+    }
+  }
+  else{
+    for (unsigned int dof=0; dof<dst.local_size(); ++dof){
+      dst.local_element(dof)=dst2.local_element(dof);
+    }
+    for (unsigned int i=0; i<edgeIndices.size(); i++){
+      dst.local_element(edgeIndices[i])=0.0;
+    }
+  }
+  for (unsigned int i=0; i<dirichletIndices.size(); i++){
+    dst.local_element(dirichletIndices[i])=0.0;
+  }
+}
+
+//size of the current field on a level
+template <int dim>
+types::global_dof_index MatrixFreePDE<dim>::levelSize (const unsigned int level) const{
+  return dofHandlersSet[currentFieldIndex]->n_dofs(level);
+}
+
+//initialize a vector with the layout of the current field on a level
+template <int dim>
+void MatrixFreePDE<dim>::initializeLevelVector (const unsigned int level, vectorType &vec) const{
+  mgMatrixFreeSet[level]->initialize_dof_vector(vec, currentFieldIndex);
+}
+
+#endif
@@ -40,10 +40,16 @@ void MatrixFreePDE<dim>::adaptiveRefineCriterion(){
 
 //refine grid method
 template <int dim>
-void MatrixFreePDE<dim>::refineGrid (){
+bool MatrixFreePDE<dim>::refineGrid (){
 #if hAdaptivity==true 
-  //call refinement criterion for adaptivity
-  adaptiveRefineCriterion();
+  //call refinement criterion for adaptivity, unless isRemeshingRequired() already did on this mesh
+  if (!refineFlagsSet){
+    adaptiveRefineCriterion();
+  }
+  refineFlagsSet = false;
+
+  //the cells flagged for refinement by the criterion are the interface cells of the cost model of the repartitioning
+  markInterfaceCells();
   
   //limit the maximal refinement depth of the mesh
   pcout << "Current mesh refinement level: " << triangulation.n_levels() << "\n";
@@ -62,11 +68,163 @@ void MatrixFreePDE<dim>::refineGrid (){
 
   //prepare and refine
   triangulation.prepare_coarsening_and_refinement();
+
+  //skip the refinement if no cell remains flagged on any process, the mesh and everything built on it are then unchanged
+  unsigned int flaggedCells = 0;
+  for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+    if (cell->is_locally_owned() && (cell->refine_flag_set() || cell->coarsen_flag_set())){
+      flaggedCells++;
+    }
+  }
+  if (Utilities::MPI::sum(flaggedCells, MPI_COMM_WORLD) == 0){
+    return false;
+  }
+
   for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
     (*residualSet[fieldIndex])=(*solutionSet[fieldIndex]);
     soltransSet[fieldIndex]->prepare_for_coarsening_and_refinement(*residualSet[fieldIndex]);
   }
   triangulation.execute_coarsening_and_refinement();
+  return true;
+#else
+  return false;
+#endif
+}
+
+//mark the active cells flagged for refinement by the refinement criterion as interface cells
+template <int dim>
+void MatrixFreePDE<dim>::markInterfaceCells (){
+  interfaceCellSet.assign(triangulation.n_active_cells(), false);
+  for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+    if (cell->is_locally_owned() && cell->refine_flag_set()){
+      interfaceCellSet[cell->active_cell_index()] = true;
+    }
+  }
+}
+
+//modeled cost of an active cell relative to a bulk cell without hanging nodes
+template <int dim>
+double MatrixFreePDE<dim>::cellCost (const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell) const {
+  double cost = 1.0;
+  if ((cell->active_cell_index() < interfaceCellSet.size()) && interfaceCellSet[cell->active_cell_index()]){
+    cost *= interfaceCellWeight;
+  }
+  for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; face++){
+    if (!cell->at_boundary(face) && (cell->face(face)->has_children() || cell->neighbor_is_coarser(face))){
+      cost *= hangingNodeCellWeight;
+      break;
+    }
+  }
+  return cost;
+}
+
+//weight of a cell for the weighted repartitioning in execute_coarsening_and_refinement(), called on the cells of the mesh before
+//the refinement. The triangulation adds its own base weight to the returned weight of each cell, so the full weight of the cell is
+//computed in units of that base weight and the base weight is subtracted again. A refined cell passes its weight to each of its
+//children, and a coarsened cell (the parent of the active cells that are coarsened) gets the largest cost among its children.
+template <int dim>
+unsigned int MatrixFreePDE<dim>::cellWeight (const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+                                            const typename parallel::distributed::Triangulation<dim>::CellStatus status) const {
+#if DEAL_II_VERSION_GTE(8,4,0)
+  //base weight of 1000 per cell of the cell_weight signal
+  const double baseWeight = 1000.0;
+#else
+  //no cell_weight signal, the weight is unused
+  const double baseWeight = 0.0;
+#endif
+  if (status == parallel::distributed::Triangulation<dim>::CELL_INVALID){
+    return 0;
+  }
+  double cost = 0.0;
+  if (status == parallel::distributed::Triangulation<dim>::CELL_COARSEN){
+    for (unsigned int child=0; child<cell->n_children(); child++){
+      cost = std::max(cost, cellCost(cell->child(child)));
+    }
+  }
+  else{
+    cost = cellCost(cell);
+  }
+  const double fullWeight = std::max(baseWeight, baseWeight*cost);
+  return (unsigned int) (fullWeight-baseWeight+0.5);
+}
+
+//print the largest number of cells of a process relative to the average over the processes, and with weightedRepartitioning the same
+//ratio for the modeled cost
+template <int dim>
+void MatrixFreePDE<dim>::printLoadBalance (){
+#if hAdaptivity==true
+  //with weightedRepartitioning, classify the cells of the new mesh with the refinement criterion, the flags are only needed for the classification
+  if (weightedRepartitioning){
+    adaptiveRefineCriterion();
+    markInterfaceCells();
+    for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+      cell->clear_refine_flag();
+      cell->clear_coarsen_flag();
+    }
+  }
+
+  double localCells = 0.0, localCost = 0.0;
+  for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+    if (cell->is_locally_owned()){
+      localCells += 1.0;
+      if (weightedRepartitioning) localCost += cellCost(cell);
+    }
+  }
+  const double n_processes = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const double averageCells = Utilities::MPI::sum(localCells, MPI_COMM_WORLD)/n_processes;
+  const double maxCells = Utilities::MPI::max(localCells, MPI_COMM_WORLD);
+
+  char buffer[200];
+  if (weightedRepartitioning){
+    const double averageCost = Utilities::MPI::sum(localCost, MPI_COMM_WORLD)/n_processes;
+    const double maxCost = Utilities::MPI::max(localCost, MPI_COMM_WORLD);
+    sprintf(buffer, "load imbalance (max/average per process): cells %.3f, modeled cost %.3f\n", \
+        maxCells/std::max(averageCells,1.0), maxCost/std::max(averageCost,1.0));
+  }
+  else {
+    sprintf(buffer, "load imbalance (max/average per process): cells %.3f\n", maxCells/std::max(averageCells,1.0));
+  }
+  pcout << buffer;
+#endif
+}
+
+//check whether the mesh needs to be remeshed, used by adaptiveRemeshing. The refinement criterion is evaluated on the current mesh and
+//a remesh is required if it flags a cell below maxRefinementLevel for refinement, i.e. an interface has moved out of the refined zone,
+//or after maxSkippedRemeshings checks without a remesh, so that the cells behind the interfaces are eventually coarsened. This needs a
+//criterion that only flags the cells near the interfaces (a window criterion): the fixed fraction Kelly criterion flags cells for
+//refinement on every mesh and is rejected. When a remesh is required the flags are kept for the following refineGrid().
+template <int dim>
+bool MatrixFreePDE<dim>::isRemeshingRequired (){
+#if hAdaptivity==true
+#ifdef adaptivityType
+  if (std::string(adaptivityType) == "KELLY"){
+    pcout << "\nError: adaptiveRemeshing requires a window refinement criterion, the KELLY criterion flags cells for refinement on every mesh.\n\n";
+    exit(-1);
+  }
+#endif
+  adaptiveRefineCriterion();
+  unsigned int escapedCells = 0;
+  for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+    if (cell->is_locally_owned() && cell->refine_flag_set() && (cell->level() < maxRefinementLevel)){
+      escapedCells++;
+    }
+  }
+  escapedCells = Utilities::MPI::sum(escapedCells, MPI_COMM_WORLD);
+
+  if ((escapedCells == 0) && (skippedRemeshings < maxSkippedRemeshings)){
+    for (typename parallel::distributed::Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(); cell != triangulation.end(); ++cell){
+      cell->clear_refine_flag();
+      cell->clear_coarsen_flag();
+    }
+    skippedRemeshings++;
+    return false;
+  }
+  pcout << "Remeshing: " << escapedCells << " cells outside the refined zone need refinement (" << skippedRemeshings << " remeshings skipped)\n";
+  skippedRemeshings = 0;
+  refineFlagsSet = true;
+  return true;
+#else
+  return false;
 #endif
 }
 
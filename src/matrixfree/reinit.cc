@@ -11,7 +11,15 @@
 
 	 computing_timer.enter_section("matrixFreePDE: reinitialization");
 
-	 refineGrid();
+	 // Nothing depends on a mesh that the refinement left unchanged
+	 if (!refineGrid()){
+		 pcout << "No cells flagged for refinement or coarsening, keeping the mesh\n";
+		 computing_timer.exit_section("matrixFreePDE: reinitialization");
+		 return;
+	 }
+
+	 // The reusable FEEvaluation objects refer to the matrix free objects that are rebuilt below
+	 clearEvaluatorPools();
 
 	 //setup system
 	 pcout << "Reinitializing matrix free object\n";
@@ -30,6 +38,9 @@
 		 dof_handler=dofHandlersSet_nonconst.at(it->index);
 
 		 dof_handler->distribute_dofs (*fe);
+		 if (isMultigridPreconditioned){
+			 dof_handler->distribute_mg_dofs (*fe);
+		 }
 		 totalDOFs+=dof_handler->n_dofs();
 
 		 //extract locally_relevant_dofs
@@ -65,15 +76,8 @@
 		 constraintsDirichlet->close();
 		 constraintsOther->close();
 
-		 // Store Dirichlet BC DOF's
-		 valuesDirichletSet[it->index]->clear();
-		 for (types::global_dof_index i=0; i<dof_handler->n_dofs(); i++){
-			 if (locally_relevant_dofs->is_element(i)){
-				 if (constraintsDirichlet->is_constrained(i)){
-					 (*valuesDirichletSet[it->index])[i] = constraintsDirichlet->get_inhomogeneity(i);
-				 }
-			 }
-		 }
+		 // Store the locally owned Dirichlet BC DOF's
+		 storeDirichletDOFs(it->index);
 
 		 sprintf(buffer, "field '%2s' DOF : %u (Constraint DOF : %u)\n", \
 				 it->name.c_str(), dof_handler->n_dofs(), constraintsDirichlet->n_constraints());
@@ -82,19 +86,32 @@
  	 pcout << "total DOF : " << totalDOFs << std::endl;
 
  	 // Setup the matrix free object
- 	 typename MatrixFree<dim,double>::AdditionalData additional_data;
+ 	 typename MatrixFree<dim,numberType>::AdditionalData additional_data;
  	 additional_data.mpi_communicator = MPI_COMM_WORLD;
- 	 additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+ 	 additional_data.tasks_parallel_scheme = MatrixFree<dim,numberType>::AdditionalData::partition_partition;
  	 additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
  	 QGaussLobatto<1> quadrature (finiteElementDegree+1);
  	 matrixFreeObject.clear();
+ 	 #if hAdaptivity==true
+ 	 // Gauss-Lobatto points for the cell kernels (quadrature index 0) and Gauss points for the refinement criterion (quadrature index 1)
+ 	 std::vector<Quadrature<1> > quadratures;
+ 	 quadratures.push_back(quadrature);
+ 	 quadratures.push_back(QGauss<1>(finiteElementDegree+1));
+ 	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadratures, additional_data);
+ 	 #else
  	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadrature, additional_data);
+ 	 #endif
+
+ 	 // Setup the level matrix free objects and transfer operators of the multigrid preconditioner
+ 	 setupMultigrid();
 
  	bool dU_scalar_init = false;
  	bool dU_vector_init = false;
  
  	 // Setup solution vectors
  	 pcout << "initializing parallel::distributed residual and solution vectors\n";
+ 	 vmultScratchSet.resize(fields.size());
+ 	 mixedPrecisionScratchSet.resize(fields.size());
  	 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
  		 vectorType *U;
 
@@ -105,6 +122,10 @@
  		// Initializing temporary dU vector required for implicit solves of the elliptic equation.
  		// Assuming here that there is only one elliptic field in the problem (the main problem is if one is a scalar and the other is a vector, because then dU would need to be different sizes)
  		if (fields[fieldIndex].pdetype==ELLIPTIC){
+ 			matrixFreeObject.initialize_dof_vector(vmultScratchSet[fieldIndex],  fieldIndex);
+ 			if (mixedPrecisionEllipticSolves){
+ 				initializeMixedPrecisionScratch(fieldIndex);
+ 			}
  			if (fields[fieldIndex].type == SCALAR){
  				if (dU_scalar_init == false){
  					matrixFreeObject.initialize_dof_vector(dU_scalar,  fieldIndex);
@@ -120,6 +141,21 @@
  		}
  	 }
    
+ 	 // The previous increments of the implicit solves do not match the new mesh
+ 	 dUHistorySet.clear();
+ 	 recycledBasisSet.clear();
+ 	 recycledBasisLHSSet.clear();
+ 	 referenceResidualSet.clear();
+ 	 referenceResidualTakenSet.clear();
+ 	 skippedImplicitSolvesSet.clear();
+
+ 	 // The Runge-Kutta stages of adaptiveTimeStepping do not match the new mesh
+ 	 rkVectorSet.clear();
+ 	 activeCellBatchSet.clear();
+
+ 	 // Reallocate the vectors of the IMEX solves (the previous increments are reset to zero)
+ 	 setupIMEXFields();
+
  	 // Compute invM in PDE is a time-dependent BVP
  	 if (isTimeDependentBVP){
  		 computeInvM();
@@ -149,6 +185,15 @@
 		 solutionSet[fieldIndex]->update_ghost_values();
  	 }
 
+ 	 // Recompute the LHS diagonal used by the JACOBI and CHEBYSHEV preconditioners
+ 	 computeLHSDiagonal();
+
+ 	 // Build the multigrid preconditioners of the elliptic fields
+ 	 updateMultigrid();
+
+ 	 // Report the balance of the new partition
+ 	 printLoadBalance();
+
  	 computing_timer.exit_section("matrixFreePDE: reinitialization");
 }
 
@@ -20,6 +20,11 @@ void MatrixFreePDE<dim>::solve(){
 
   //time dependent BVP
   if (isTimeDependentBVP){
+    //grain tracking and remapping of the initial conditions
+    if (grainRemapping){
+      remapGrains();
+    }
+
     //output initial conditions for time dependent BVP
 	  if ((writeOutput) && (outputTimeStepList[currentOutput] == 0)) {
 
@@ -33,6 +38,13 @@ void MatrixFreePDE<dim>::solve(){
 			  currentOutput++;
     }
     
+    //time stepping with adaptive time steps
+    if (adaptiveTimeStepping){
+      solveAdaptiveTimeSteps(currentOutput);
+      computing_timer.exit_section("matrixFreePDE: solve");
+      return;
+    }
+
     //time stepping
     pcout << "\nTime stepping parameters: timeStep: " << dtValue << "  timeFinal: " << finalTime << "  timeIncrements: " << totalIncrements << "\n";
     
@@ -57,6 +69,11 @@ void MatrixFreePDE<dim>::solve(){
     	  solutionSet[fieldIndex]->update_ghost_values();
       }
 
+      //grain tracking and remapping of the order parameters
+      if ((grainRemapping) && (currentIncrement%skipGrainRemappingSteps==0)){
+        remapGrains();
+      }
+
       //output results to file
       if ((writeOutput) && (outputTimeStepList[currentOutput] == currentIncrement)) {
     	  outputResults();
@@ -5,6 +5,111 @@
 //this source file is temporarily treated as a header file (hence
 //#ifndef's) till library packaging scheme is finalized
 
+//explicit update of a range of the local DOFs of a set of parabolic fields
+template <int dim>
+double MatrixFreePDE<dim>::updateExplicitFieldsRange(const std::vector<unsigned int> &fieldIndices, const unsigned int begin, const unsigned int end) const{
+	const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+	const unsigned int invM_size = invM.local_size();
+	const double *invM_values = invM.begin();
+
+	// Sum of (u-u) over the updated values, which is zero unless a value is NaN or Inf
+	VectorizedArray<double> check_lanes = make_vectorized_array(0.0);
+	double check = 0.0;
+
+	for (unsigned int i=0; i<fieldIndices.size(); i++){
+		// The length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
+		const unsigned int n_blocks = solutionSet[fieldIndices[i]]->local_size()/invM_size;
+		for (unsigned int block=0; block<n_blocks; block++){
+			double *solution = solutionSet[fieldIndices[i]]->begin() + block*invM_size;
+			const double *residual = residualSet[fieldIndices[i]]->begin() + block*invM_size;
+
+			unsigned int dof=begin;
+			for (; dof+n_lanes<=end; dof+=n_lanes){
+				VectorizedArray<double> invM_dof, residual_dof;
+				invM_dof.load(invM_values+dof);
+				residual_dof.load(residual+dof);
+				const VectorizedArray<double> solution_dof = invM_dof*residual_dof;
+				solution_dof.store(solution+dof);
+				check_lanes += solution_dof-solution_dof;
+			}
+			for (; dof<end; ++dof){
+				solution[dof] = invM_values[dof]*residual[dof];
+				check += solution[dof]-solution[dof];
+			}
+		}
+	}
+
+	for (unsigned int lane=0; lane<n_lanes; lane++){
+		check += check_lanes[lane];
+	}
+	return check;
+}
+
+//explicit update of a set of parabolic fields, returns the (local) finiteness check of the updated values
+template <int dim>
+double MatrixFreePDE<dim>::updateExplicitFields(const std::vector<unsigned int> &fieldIndices){
+	return parallel::accumulate_from_subranges<double>(std_cxx11::bind(&MatrixFreePDE<dim>::updateExplicitFieldsRange,
+			this, std_cxx11::cref(fieldIndices), std_cxx11::_1, std_cxx11::_2), 0, invM.local_size(), 4096);
+}
+
+//decide whether the implicit solve of an elliptic field is done in the current increment
+template <int dim>
+bool MatrixFreePDE<dim>::isImplicitSolveRequired(unsigned int fieldIndex){
+  if (adaptiveSkipImplicitSolves == false){
+	  return (currentIncrement%skipImplicitSolves==0);
+  }
+
+  if (referenceResidualSet.size() != fields.size()){
+	  referenceResidualSet.assign(fields.size(), 0.0);
+	  referenceResidualTakenSet.assign(fields.size(), false);
+	  skippedImplicitSolvesSet.assign(fields.size(), 0);
+  }
+
+  // Residual norm without the Dirichlet DOFs (their residual is replaced by the Dirichlet values before the solve)
+  vectorType &R = *residualSet[fieldIndex];
+  for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+	  R.local_element(dirichletLocalIndicesSet[fieldIndex][i]) = 0.0;
+  }
+  double residual_norm = R.l2_norm();
+  double reference_norm = referenceResidualSet[fieldIndex];
+  // A zero reference (every solve so far started from a zero residual) is replaced by the one for which implicitSolveResidualThreshold
+  // gives the absolute floor implicitSolveResidualFloor
+  double relative_residual = residual_norm/(reference_norm > 0.0 ? reference_norm : implicitSolveResidualFloor/implicitSolveResidualThreshold);
+
+  std::string reason;
+  if (referenceResidualTakenSet[fieldIndex] == false){
+	  reason = "first solve";
+  }
+  else if (relative_residual > implicitSolveResidualThreshold){
+	  reason = "residual above threshold";
+  }
+  else if (skippedImplicitSolvesSet[fieldIndex] >= maxSkippedImplicitSolves){
+	  reason = "maximum number of skipped solves reached";
+  }
+
+  char buffer[200];
+  if (currentIncrement%skipPrintSteps==0){
+	  if (reason.empty()){
+		  sprintf(buffer, "field '%2s' [implicit solve]: skipped, relative residual:%12.6e, consecutive skipped solves:%u\n", \
+				  fields[fieldIndex].name.c_str(), relative_residual, skippedImplicitSolvesSet[fieldIndex]+1);
+	  }
+	  else {
+		  sprintf(buffer, "field '%2s' [implicit solve]: performed (%s), relative residual:%12.6e, consecutive skipped solves:%u\n", \
+				  fields[fieldIndex].name.c_str(), reason.c_str(), relative_residual, skippedImplicitSolvesSet[fieldIndex]);
+	  }
+	  pcout << buffer;
+  }
+
+  if (reason.empty()){
+	  skippedImplicitSolvesSet[fieldIndex]++;
+	  return false;
+  }
+  referenceResidualSet[fieldIndex] = std::max(reference_norm, residual_norm);
+  referenceResidualTakenSet[fieldIndex] = true;
+  skippedImplicitSolvesSet[fieldIndex] = 0;
+  return true;
+}
+
 //solve each time increment
 template <int dim>
 void MatrixFreePDE<dim>::solveIncrement(){
@@ -20,23 +125,49 @@ void MatrixFreePDE<dim>::solveIncrement(){
 	
   //compute residual vectors
 
+  // The fields coupled to IMEX fields are first updated explicitly, so that the IMEX solves use them at the current time
+  std::vector<unsigned int> imexCoupledFieldIndices;
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+	  if (isIMEXCoupledField[fieldIndex]) imexCoupledFieldIndices.push_back(fieldIndex);
+  }
+  if (imexCoupledFieldIndices.size() > 0){
+	  computeRHS();
+	  solutionCheck += updateExplicitFields(imexCoupledFieldIndices);
+	  for (unsigned int i=0; i<imexCoupledFieldIndices.size(); i++){
+		  constraintsOtherSet[imexCoupledFieldIndices[i]]->distribute(*solutionSet[imexCoupledFieldIndices[i]]);
+		  constraintsDirichletSet[imexCoupledFieldIndices[i]]->distribute(*solutionSet[imexCoupledFieldIndices[i]]);
+		  solutionSet[imexCoupledFieldIndices[i]]->update_ghost_values();
+	  }
+  }
+
   computeRHS();
 
+  // The parabolic fields updated by the explicit time step (not the IMEX fields and their coupled fields, which are already updated),
+  // grouped by runs of consecutive PARABOLIC fields. Each group is stored at its first field and is updated at once when it is reached.
+  std::vector<std::vector<unsigned int> > explicitFieldGroups(fields.size());
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+	  if ((fields[fieldIndex].pdetype != PARABOLIC) || isIMEXField[fieldIndex] || isIMEXCoupledField[fieldIndex]) continue;
+	  unsigned int groupIndex = fieldIndex;
+	  for (unsigned int i=fieldIndex; (i>0) && (fields[i-1].pdetype == PARABOLIC); i--){
+		  if (!isIMEXField[i-1] && !isIMEXCoupledField[i-1]) groupIndex = i-1;
+	  }
+	  explicitFieldGroups[groupIndex].push_back(fieldIndex);
+  }
+
   //solve for each field
   for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
 	  currentFieldIndex = fieldIndex; // Used in computeLHS()
 
+    //Parabolic fields advanced with the IMEX scheme
+    if ((fields[fieldIndex].pdetype==PARABOLIC) && isIMEXField[fieldIndex]){
+    	solveIMEXIncrement(fieldIndex);
+    }
     //Parabolic (first order derivatives in time) fields
-    if (fields[fieldIndex].pdetype==PARABOLIC){
+    else if (fields[fieldIndex].pdetype==PARABOLIC){
 
-    	// Explicit-time step each DOF
-    	// Takes advantage of knowledge that the length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
-    	unsigned int invM_size = invM.local_size();
-
-    	for (unsigned int dof=0; dof<solutionSet[fieldIndex]->local_size(); ++dof){
-
-    		solutionSet[fieldIndex]->local_element(dof)=			\
-    				invM.local_element(dof%invM_size)*residualSet[fieldIndex]->local_element(dof);
+    	// Explicit-time step each DOF, for the group of parabolic fields starting at this field at once
+    	if (!explicitFieldGroups[fieldIndex].empty()){
+    		solutionCheck += updateExplicitFields(explicitFieldGroups[fieldIndex]);
     	}
 
       //apply constraints
@@ -57,13 +188,11 @@ void MatrixFreePDE<dim>::solveIncrement(){
 
     	//implicit solve
 		#ifdef solverType
-		if (currentIncrement%skipImplicitSolves==0){
+		if (isImplicitSolveRequired(fieldIndex)){
 			//apply Dirichlet BC's
-			// Loops through all DoF to which ones have Dirichlet BCs applied, replace the ones that do with the Dirichlet value
-			for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[fieldIndex]->begin(); it!=valuesDirichletSet[fieldIndex]->end(); ++it){
-				if (residualSet[fieldIndex]->in_local_range(it->first)){
-					(*residualSet[fieldIndex])(it->first) = it->second; //*jacobianDiagonal(it->first);
-				}
+			// Loops through the locally owned DoF with Dirichlet BCs applied and replaces the residual with the Dirichlet value
+			for (unsigned int i=0; i<dirichletLocalIndicesSet[fieldIndex].size(); i++){
+				residualSet[fieldIndex]->local_element(dirichletLocalIndicesSet[fieldIndex][i]) = dirichletLocalValuesSet[fieldIndex][i];
 			}
 	
 			//solver controls
@@ -74,26 +203,35 @@ void MatrixFreePDE<dim>::solveIncrement(){
 			#endif
 			solverType<vectorType> solver(solver_control);
 	
-			//solve
+			//solve, with the other fields cached at the quadrature points for the LHS
+			vectorType &dU = (fields[fieldIndex].type == SCALAR ? dU_scalar : dU_vector);
+			cacheLHSFields(fieldIndex);
+			bool converged = true;
 			try{
-				if (fields[fieldIndex].type == SCALAR){
-					dU_scalar=0.0;
-					solver.solve(*this, dU_scalar, *residualSet[fieldIndex], IdentityMatrix(solutionSet[fieldIndex]->size()));
+				getImplicitInitialGuess(fieldIndex, dU, *residualSet[fieldIndex]);
+				if (mixedPrecisionEllipticSolves){
+					solveLinearSystemMixedPrecision(solver_control, dU, *residualSet[fieldIndex]);
 				}
 				else {
-					dU_vector=0.0;
-					solver.solve(*this, dU_vector, *residualSet[fieldIndex], IdentityMatrix(solutionSet[fieldIndex]->size()));
+					solveLinearSystem(solver, dU, *residualSet[fieldIndex]);
 				}
 			}
 			catch (...) {
+				converged = false;
 				pcout << "\nWarning: implicit solver did not converge as per set tolerances. consider increasing maxSolverIterations or decreasing solverTolerance.\n";
 			}
-			if (fields[fieldIndex].type == SCALAR){
-				*solutionSet[fieldIndex]+=dU_scalar;
+			// Add the increment, checking the updated values in the same pass
+			for (unsigned int dof=0; dof<solutionSet[fieldIndex]->local_size(); ++dof){
+				solutionSet[fieldIndex]->local_element(dof) += dU.local_element(dof);
+				solutionCheck += solutionSet[fieldIndex]->local_element(dof)-solutionSet[fieldIndex]->local_element(dof);
+			}
+			if (converged){
+				storeImplicitIncrement(fieldIndex, dU);
 			}
 			else {
-				*solutionSet[fieldIndex]+=dU_vector;
+				resetImplicitIncrements(fieldIndex);
 			}
+			clearLHSFieldCache();
 
 			// Apply hanging node and periodic constraints
 			constraintsOtherSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
@@ -101,13 +239,7 @@ void MatrixFreePDE<dim>::solveIncrement(){
 			solutionSet[fieldIndex]->update_ghost_values();
 			//
 			 if (currentIncrement%skipPrintSteps==0){
-				 double dU_norm;
-				 if (fields[fieldIndex].type == SCALAR){
-					 dU_norm = dU_scalar.l2_norm();
-				 }
-				 else {
-					 dU_norm = dU_vector.l2_norm();
-				 }
+				 double dU_norm = dU.l2_norm();
 			sprintf(buffer, "field '%2s' [implicit solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, tolerance criterion:%12.6e, solution: %12.6e, dU: %12.6e\n", \
 					fields[fieldIndex].name.c_str(),			\
 					residualSet[fieldIndex]->l2_norm(),			\
@@ -116,7 +248,7 @@ void MatrixFreePDE<dim>::solveIncrement(){
 			pcout<<buffer;
 			 }
 		}
-		else{
+		else if ((adaptiveSkipImplicitSolves == false) && (currentIncrement%skipPrintSteps==0)){
 			sprintf(buffer, "field '%2s' [implicit solve]: current residual:%12.6e\n", \
 					fields[fieldIndex].name.c_str(),			\
 					residualSet[fieldIndex]->l2_norm());
@@ -137,11 +269,20 @@ void MatrixFreePDE<dim>::solveIncrement(){
 		  exit(-1);
 	  }
     
-	  //check if solution is nan
-	  if (!numbers::is_finite(solutionSet[fieldIndex]->l2_norm())){
-		  sprintf(buffer, "ERROR: field '%s' solution is NAN. exiting.\n\n",
-				  fields[fieldIndex].name.c_str());
-		  pcout<<buffer;
+  }
+
+  //check if the solution is nan, with a single reduction for all the fields (the field norms are only computed to report the failure)
+  if (currentIncrement%skipNaNCheckSteps==0){
+	  double global_check = Utilities::MPI::sum(solutionCheck, MPI_COMM_WORLD);
+	  solutionCheck = 0.0;
+	  if (!numbers::is_finite(global_check)){
+		  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+			  if (!numbers::is_finite(solutionSet[fieldIndex]->l2_norm())){
+				  sprintf(buffer, "ERROR: field '%s' solution is NAN. exiting.\n\n",
+						  fields[fieldIndex].name.c_str());
+				  pcout<<buffer;
+			  }
+		  }
 		  exit(-1);
 	  }
   }
@@ -0,0 +1,121 @@
+//solveLinearSystem() method for MatrixFreePDE class
+
+#ifndef SOLVELINEARSYSTEM_MATRIXFREE_H
+#define SOLVELINEARSYSTEM_MATRIXFREE_H
+//this source file is temporarily treated as a header file (hence
+//#ifndef's) till library packaging scheme is finalized
+
+//solve the linear system for the increment of the current field, using the preconditioner set by preconditionerType
+template <int dim>
+template <typename SolverType>
+void MatrixFreePDE<dim>::solveLinearSystem(SolverType &solver, vectorType &dU, const vectorType &R){
+	std::string preconditioner_type = preconditionerType;
+
+	if (preconditioner_type == "NONE"){
+		solver.solve(*this, dU, R, IdentityMatrix(R.size()));
+	}
+	else if (preconditioner_type == "JACOBI"){
+		solver.solve(*this, dU, R, *diagonalInverseSet[currentFieldIndex]);
+	}
+	else if (preconditioner_type == "CHEBYSHEV"){
+		// Chebyshev-accelerated Jacobi, built in computeLHSDiagonal()
+		solver.solve(*this, dU, R, *chebyshevPreconditionerSet[currentFieldIndex]);
+	}
+	else if (preconditioner_type == "MULTIGRID"){
+		#if DEAL_II_VERSION_GTE(8,5,0)
+		// V-cycle with the level operators and smoothers built in updateMultigrid()
+		solver.solve(*this, dU, R, *mgPreconditionerSet[currentFieldIndex]->preconditioner);
+		#else
+		pcout << "\nError: the MULTIGRID preconditioner requires deal.II version 8.5 or later.\n\n";
+		exit(-1);
+		#endif
+	}
+	else {
+		pcout << "\nError: unknown preconditionerType '" << preconditioner_type << "'. Valid options are NONE, JACOBI, CHEBYSHEV and MULTIGRID.\n\n";
+		exit(-1);
+	}
+}
+
+//allocate the vectors of the mixed precision implicit solves of a field
+template <int dim>
+void MatrixFreePDE<dim>::initializeMixedPrecisionScratch(const unsigned int fieldIndex){
+	mixedPrecisionScratch &scratch = mixedPrecisionScratchSet[fieldIndex];
+	matrixFreeObject.initialize_dof_vector(scratch.defect, fieldIndex);
+	matrixFreeObject.initialize_dof_vector(scratch.defectSinglePrecision, fieldIndex);
+	matrixFreeObject.initialize_dof_vector(scratch.correctionSinglePrecision, fieldIndex);
+	matrixFreeObject.initialize_dof_vector(scratch.vmultSrc, fieldIndex);
+}
+
+//solve the linear system for the increment of the current field by defect correction. Each correction is computed by an inner solve
+//with the single precision operator and preconditioner (to the relative tolerance innerSolverTolerance), and the residual of the
+//outer loop is computed in double precision, so the solve stops at the tolerance of solver_control as the double precision solve does
+template <int dim>
+void MatrixFreePDE<dim>::solveLinearSystemMixedPrecision(SolverControl &solver_control, vectorType &dU, const vectorType &R){
+	std::string preconditioner_type = preconditionerType;
+	if ((preconditioner_type != "NONE") && (preconditioner_type != "JACOBI") && (preconditioner_type != "CHEBYSHEV")){
+		pcout << "\nError: mixedPrecisionEllipticSolves supports the NONE, JACOBI and CHEBYSHEV preconditioners only.\n\n";
+		exit(-1);
+	}
+
+	// Vectors of the defect correction loop, and the single precision preconditioners built in computeLHSDiagonal()
+	mixedPrecisionScratch &scratch = mixedPrecisionScratchSet[currentFieldIndex];
+	vectorType &defect = scratch.defect;
+	floatVectorType &defectSinglePrecision = scratch.defectSinglePrecision;
+	floatVectorType &correctionSinglePrecision = scratch.correctionSinglePrecision;
+
+	// Defect of the initial guess
+	vmult(defect, dU);
+	defect.sadd(-1.0, 1.0, R);
+	double defect_norm = defect.l2_norm();
+
+	unsigned int step = 0, innerIterations = 0;
+	double innerSolveTime = 0.0;
+	SolverControl::State state = solver_control.check(step, defect_norm);
+	while (state == SolverControl::iterate){
+		// Inner solve for the correction, starting from zero
+		defectSinglePrecision = defect;
+		correctionSinglePrecision = 0.0;
+		SolverControl inner_control(maxSolverIterations, innerSolverTolerance*defect_norm);
+		solverType<floatVectorType> inner_solver(inner_control);
+		Timer innerSolveTimer;
+		try{
+			if (preconditioner_type == "NONE"){
+				inner_solver.solve(*this, correctionSinglePrecision, defectSinglePrecision, IdentityMatrix(R.size()));
+			}
+			else if (preconditioner_type == "JACOBI"){
+				inner_solver.solve(*this, correctionSinglePrecision, defectSinglePrecision, *diagonalInverseSinglePrecisionSet[currentFieldIndex]);
+			}
+			else {
+				inner_solver.solve(*this, correctionSinglePrecision, defectSinglePrecision, *chebyshevPreconditionerSinglePrecisionSet[currentFieldIndex]);
+			}
+		}
+		catch (...) {
+			// An unconverged inner solve still reduces the defect, the outer loop decides on convergence
+		}
+		innerSolveTime += innerSolveTimer.wall_time();
+		innerIterations += inner_control.last_step();
+
+		// Add the correction and update the defect in double precision
+		for (unsigned int dof=0; dof<dU.local_size(); ++dof){
+			dU.local_element(dof) += correctionSinglePrecision.local_element(dof);
+		}
+		vmult(defect, dU);
+		defect.sadd(-1.0, 1.0, R);
+		defect_norm = defect.l2_norm();
+
+		step++;
+		state = solver_control.check(step, defect_norm);
+	}
+
+	// The measured wall time per single precision iteration (including the preconditioner) is printed with the iteration counts
+	if (currentIncrement%skipPrintSteps==0){
+		char buffer[250];
+		sprintf(buffer, "field '%2s' [mixed precision solve]: defect correction steps:%u, single precision iterations:%u, time per iteration:%12.6e s\n", \
+				fields[currentFieldIndex].name.c_str(), step, innerIterations, (innerIterations > 0 ? innerSolveTime/innerIterations : 0.0));
+		pcout << buffer;
+	}
+
+	AssertThrow(state == SolverControl::success, SolverControl::NoConvergence(step, defect_norm));
+}
+
+#endif
@@ -68,10 +68,28 @@ class generalizedProblem: public MatrixFreePDE<dim>
 
   // Elasticity matrix variables
   const static unsigned int CIJ_tensor_size = 2*dim-1+dim/3;
-  std::vector<dealii::Tensor<2, CIJ_tensor_size, dealii::VectorizedArray<double> > > CIJ_list;
+  std::vector<dealii::Tensor<2, CIJ_tensor_size, scalarType> > CIJ_list;
 
   Threads::Mutex assembler_lock;
 
+  // FEEvaluation objects and quadrature point lists reused by the cell loops of each thread
+  struct evaluatorPool
+  {
+	  evaluatorPool(): data(NULL), is_LHS(false) {}
+	  const MatrixFree<dim,numberType> *data;
+	  bool is_LHS;
+	  std::vector<typeScalar> scalar_vars;
+	  std::vector<typeVector> vector_vars;
+	  std::vector<modelVariable<dim> > modelVarList;
+	  dealii::AlignedVector<scalarType> modelVarStorage;
+	  std::vector<modelResidual<dim> > modelResidualsList;
+	  std::vector<bool> activeVariables;
+	  dealii::AlignedVector<scalarType> JxW;
+  };
+  mutable Threads::ThreadLocalStorage<std::list<evaluatorPool> > evaluatorPools;
+  evaluatorPool & getEvaluatorPool(const MatrixFree<dim,numberType> &data, const bool is_LHS) const;
+  void clearEvaluatorPools();
+
   // Variables needed to calculate the LHS
   std::vector<variable_info<dim> > varInfoListRHS;
   std::vector<variable_info<dim> > resInfoListRHS;
@@ -81,22 +99,60 @@ class generalizedProblem: public MatrixFreePDE<dim>
   std::vector<variable_info<dim> > varInfoListLHS;
 
   //RHS implementation for explicit solve
-  void getRHS(const MatrixFree<dim,double> &data, 
+  void getRHS(const MatrixFree<dim,numberType> &data, 
 	      std::vector<vectorType*> &dst, 
 	      const std::vector<vectorType*> &src,
 	      const std::pair<unsigned int,unsigned int> &cell_range) const;
     
   //LHS implementation for implicit solve 
-  void  getLHS(const MatrixFree<dim,double> &data, 
+  void  getLHS(const MatrixFree<dim,numberType> &data, 
 	       vectorType &dst, 
 	       const vectorType &src,
 	       const std::pair<unsigned int,unsigned int> &cell_range) const;
+  void  getLHSBlock(const MatrixFree<dim,numberType> &data,
+	       vectorType &dst,
+	       const vectorType &src,
+	       const std::pair<unsigned int,unsigned int> &cell_range,
+	       const unsigned int fieldIndex,
+	       const unsigned int srcFieldIndex) const;
+  void  getLHSSinglePrecision(const MatrixFree<dim,numberType> &data,
+	       floatVectorType &dst,
+	       const floatVectorType &src,
+	       const std::pair<unsigned int,unsigned int> &cell_range) const;
+  template <typename Number>
+  void  getLHSCells(const MatrixFree<dim,numberType> &data,
+	       dealii::parallel::distributed::Vector<Number> &dst,
+	       const dealii::parallel::distributed::Vector<Number> &src,
+	       const std::pair<unsigned int,unsigned int> &cell_range,
+	       const unsigned int fieldIndex,
+	       const unsigned int srcFieldIndex) const;
+
+  //operations of the LHS cell loops shared by getLHSCells and getLHSDiagonal
+  variable_info<dim> getLHSResidualInfo(const unsigned int fieldIndex) const;
+  void evaluateLHSFields(evaluatorPool &pool, const std::vector<vectorType*> &fieldSet,
+	       const unsigned int srcFieldIndex, const unsigned int cell, const bool use_cache) const;
+  void submitLHSResiduals(evaluatorPool &pool, const variable_info<dim> &resInfoLHS, const unsigned int srcFieldIndex,
+	       const scalarType *cell_cache, const unsigned int n_cache_entries) const;
+
+  //cache of the non-solved fields at the quadrature points of each cell for getLHS, built before each implicit solve
+  std::vector<std::vector<scalarType> > lhsFieldCacheSet;
+  std::vector<unsigned int> lhsFieldCacheEntriesSet;
+  unsigned int getLHSCacheEntries(const variable_info<dim> &varInfo) const;
+  void cacheLHSFields(unsigned int fieldIndex);
+  void clearLHSFieldCache();
+
+  //diagonal of the LHS operator, used by the preconditioners of the implicit solve
+  void  getLHSDiagonal(const MatrixFree<dim,numberType> &data,
+	       vectorType &dst,
+	       const vectorType &src,
+	       const std::pair<unsigned int,unsigned int> &cell_range) const;
 
   //method to apply initial conditions
   void applyInitialConditions();
  
   //methods to apply dirichlet BC's on displacement
   void applyDirichletBCs();
+  void getLevelDirichletIndices(std::vector<IndexSet> &);
 
   // method to modify the fields for nucleation
   void modifySolutionFields();
@@ -111,7 +167,7 @@ class generalizedProblem: public MatrixFreePDE<dim>
   //void setRigidBodyModeConstraints( std::vector<int>, ConstraintMatrix*, DoFHandler<dim>*);
 
 
-  void getEnergy(const MatrixFree<dim,double> &data,
+  void getEnergy(const MatrixFree<dim,numberType> &data,
     				    std::vector<vectorType*> &dst,
     				    const std::vector<vectorType*> &src,
     				    const std::pair<unsigned int,unsigned int> &cell_range);
@@ -119,14 +175,14 @@ class generalizedProblem: public MatrixFreePDE<dim>
 
   void residualRHS(const std::vector<modelVariable<dim> > & modelVarList,
 		  	  	  	  	  	  	  	  	  	  	  	  	  std::vector<modelResidual<dim> > & modelResidualsList,
-														  dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const;
+														  dealii::Point<dim, scalarType> q_point_loc) const;
 
   void residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
   		  	  	  	  	  	  	  	  	  	  	  	  	  modelResidual<dim> & modelRes,
-														  dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const;
+														  dealii::Point<dim, scalarType> q_point_loc) const;
 
-  void energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const dealii::VectorizedArray<double> & JxW_value,
-		  	  	  	  	  	  	  	  	  	  	  	  	  dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc);
+  void energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const scalarType & JxW_value,
+		  	  	  	  	  	  	  	  	  	  	  	  	  dealii::Point<dim, scalarType> q_point_loc);
 
   //AMR methods
   void adaptiveRefine(unsigned int currentIncrement);
@@ -115,7 +115,7 @@ generalizedProblem<dim>::generalizedProblem(): MatrixFreePDE<dim>()
 
 	elasticityModel mat_model;
 
-	dealii::Tensor<2, CIJ_tensor_size, dealii::VectorizedArray<double> > CIJ_temp;
+	dealii::Tensor<2, CIJ_tensor_size, scalarType> CIJ_temp;
 	for (unsigned int mater_num=0; mater_num < temp_mat_consts.size(); mater_num++){
 		if (temp_mat_models[mater_num] == "ISOTROPIC"){
 			mat_model = ISOTROPIC;
@@ -204,62 +204,248 @@ for (unsigned int i=0; i<num_var; i++){
 // RESIDUAL CONSTRUCTION FUNCTIONS (RHS, LHS, ENERGY DENSITY)
 // =====================================================================
 
+// FEEvaluation objects and quadrature point lists of the calling thread for the variables of the RHS (is_LHS=false) or the
+// LHS (is_LHS=true) on the given matrix free object. They are built on the first use after init() or reinit() and then reused
+// by all the cell loops of the thread, so that getRHS, getLHS and getEnergy do not allocate memory.
 template <int dim>
-void generalizedProblem<dim>::getRHS(const MatrixFree<dim,double> &data,
+typename generalizedProblem<dim>::evaluatorPool & generalizedProblem<dim>::getEvaluatorPool(const MatrixFree<dim,numberType> &data, const bool is_LHS) const{
+	std::list<evaluatorPool> &pools = evaluatorPools.get();
+	for (typename std::list<evaluatorPool>::iterator pool=pools.begin(); pool!=pools.end(); ++pool){
+		if ((pool->data == &data) && (pool->is_LHS == is_LHS)){
+			return *pool;
+		}
+	}
+
+	pools.push_back(evaluatorPool());
+	evaluatorPool &pool = pools.back();
+	pool.data = &data;
+	pool.is_LHS = is_LHS;
+	const std::vector<variable_info<dim> > &varInfoList = (is_LHS ? varInfoListLHS : varInfoListRHS);
+	for (unsigned int i=0; i<varInfoList.size(); i++){
+		if (varInfoList[i].is_scalar){
+			pool.scalar_vars.push_back(typeScalar(data, varInfoList[i].global_var_index));
+		}
+		else {
+			pool.vector_vars.push_back(typeVector(data, varInfoList[i].global_var_index));
+		}
+	}
+	if (is_LHS){
+		setupModelVariables(varInfoList, need_value_LHS, need_gradient_LHS, need_hessian_LHS, pool.modelVarList, pool.modelVarStorage);
+	}
+	else {
+		setupModelVariables(varInfoList, need_value, need_gradient, need_hessian, pool.modelVarList, pool.modelVarStorage);
+	}
+	pool.modelResidualsList.resize(varInfoList.size());
+	pool.activeVariables.assign(varInfoList.size(), true);
+	pool.JxW.resize(typeScalar::n_q_points);
+	return pool;
+}
+
+// Discard the FEEvaluation objects of all the threads, before the matrix free objects they point to are changed
+template <int dim>
+void generalizedProblem<dim>::clearEvaluatorPools(){
+	evaluatorPools.clear();
+}
+
+// Compile-time copies of the flags set in equations.h. The loops over the variables in getRHS are unrolled by the
+// rhsVariableLoop template below, so each flag is known to the compiler and the tests on it are removed.
+static const bool rhsNeedValue[] = need_val;
+static const bool rhsNeedGradient[] = need_grad;
+static const bool rhsNeedHessian[] = need_hess;
+static const bool rhsValueResidual[] = need_val_residual;
+static const bool rhsGradientResidual[] = need_grad_residual;
+
+// Variables whose residual vanishes where the variable vanishes (sparse_var in equations.h, e.g. the order parameters of
+// grainGrowth). A cell batch where all the DOF values of such a variable are below sparseVariableTolerance (on all its
+// lanes) skips its evaluation and integration, and the variable reads as zero and is marked inactive in the residual
+// equations. The fields are still stored densely and read on every cell batch.
+#ifdef sparse_var
+static const bool rhsSparseVariable[] = sparse_var;
+#else
+static const bool rhsSparseVariable[num_var] = {false};
+#endif
+
+// Whether each variable is a scalar, from the names in variable_type (equations.h). The names are compared once, when the
+// flags are built at static initialization, and the loops over the variables read the flags as they read the ones above.
+struct rhsVariableTypeFlags {
+	bool isScalar[num_var];
+	rhsVariableTypeFlags(){
+		const char *variableType[] = variable_type;
+		for (unsigned int var=0; var<num_var; var++){
+			isScalar[var] = !strcmp(variableType[var],"SCALAR");
+		}
+	}
+};
+static const rhsVariableTypeFlags rhsVariableTypes;
+
+// Returns whether a DOF value of the cell batch is above sparseVariableTolerance
+template <typename FEEvaluationType>
+inline bool hasNonzeroDOFValues(const FEEvaluationType &fe_eval){
+	for (unsigned int k=0; k<FEEvaluationType::dofs_per_cell; k++){
+		for (unsigned int lane=0; lane<scalarType::n_array_elements; lane++){
+			if (std::abs(fe_eval.begin_dof_values()[k][lane]) > sparseVariableTolerance) return true;
+		}
+	}
+	return false;
+}
+
+// Sets the value, gradient or Hessian of a model variable to zero
+template <typename T>
+inline void setModelVariableEntryToZero(T &x){
+	scalarType *entries = reinterpret_cast<scalarType *>(&x);
+	for (unsigned int i=0; i<sizeof(T)/sizeof(scalarType); i++){
+		entries[i] = constV(0.0);
+	}
+}
+
+// Operations of getRHS on the variable var, followed by the variables var+1...n_var-1. active[var] is set by evaluate()
+// and is false for a sparse variable that vanishes on the cell batch.
+template <int dim, unsigned int var, unsigned int n_var>
+struct rhsVariableLoop
+{
+	typedef rhsVariableLoop<dim,var+1,n_var> next;
+
+	static inline void evaluate(std::vector<typeScalar> &scalar_vars, std::vector<typeVector> &vector_vars,
+			const std::vector<variable_info<dim> > &varInfoList, const std::vector<vectorType*> &src, const unsigned int cell,
+			std::vector<modelVariable<dim> > &modelVarList, std::vector<bool> &active){
+		if (rhsVariableTypes.isScalar[var]) {
+			typeScalar &fe_eval = scalar_vars[varInfoList[var].scalar_or_vector_index];
+			fe_eval.reinit(cell);
+			fe_eval.read_dof_values_plain(*src[varInfoList[var].global_var_index]);
+			active[var] = (!rhsSparseVariable[var] || hasNonzeroDOFValues(fe_eval));
+			modelVarList[var].setActive(active[var]);
+			if (active[var]){
+				fe_eval.evaluate(rhsNeedValue[var], rhsNeedGradient[var], rhsNeedHessian[var]);
+			}
+			else {
+				if (rhsNeedValue[var]) setModelVariableEntryToZero(modelVarList[var].scalarValue());
+				if (rhsNeedGradient[var]) setModelVariableEntryToZero(modelVarList[var].scalarGrad());
+				if (rhsNeedHessian[var]) setModelVariableEntryToZero(modelVarList[var].scalarHess());
+			}
+		}
+		else {
+			typeVector &fe_eval = vector_vars[varInfoList[var].scalar_or_vector_index];
+			fe_eval.reinit(cell);
+			fe_eval.read_dof_values_plain(*src[varInfoList[var].global_var_index]);
+			active[var] = (!rhsSparseVariable[var] || hasNonzeroDOFValues(fe_eval));
+			modelVarList[var].setActive(active[var]);
+			if (active[var]){
+				fe_eval.evaluate(rhsNeedValue[var], rhsNeedGradient[var], rhsNeedHessian[var]);
+			}
+			else {
+				if (rhsNeedValue[var]) setModelVariableEntryToZero(modelVarList[var].vectorValue());
+				if (rhsNeedGradient[var]) setModelVariableEntryToZero(modelVarList[var].vectorGrad());
+				if (rhsNeedHessian[var]) setModelVariableEntryToZero(modelVarList[var].vectorHess());
+			}
+		}
+		next::evaluate(scalar_vars, vector_vars, varInfoList, src, cell, modelVarList, active);
+	}
+
+	static inline void getValues(const std::vector<typeScalar> &scalar_vars, const std::vector<typeVector> &vector_vars,
+			const std::vector<variable_info<dim> > &varInfoList, std::vector<modelVariable<dim> > &modelVarList, const unsigned int q,
+			const std::vector<bool> &active){
+		if (!active[var]) {
+			// vanishing sparse variable
+		}
+		else if (rhsVariableTypes.isScalar[var]) {
+			const typeScalar &fe_eval = scalar_vars[varInfoList[var].scalar_or_vector_index];
+			if (rhsNeedValue[var]) modelVarList[var].scalarValue() = fe_eval.get_value(q);
+			if (rhsNeedGradient[var]) modelVarList[var].scalarGrad() = fe_eval.get_gradient(q);
+			if (rhsNeedHessian[var]) modelVarList[var].scalarHess() = fe_eval.get_hessian(q);
+		}
+		else {
+			const typeVector &fe_eval = vector_vars[varInfoList[var].scalar_or_vector_index];
+			if (rhsNeedValue[var]) modelVarList[var].vectorValue() = fe_eval.get_value(q);
+			if (rhsNeedGradient[var]) modelVarList[var].vectorGrad() = fe_eval.get_gradient(q);
+			if (rhsNeedHessian[var]) modelVarList[var].vectorHess() = fe_eval.get_hessian(q);
+		}
+		next::getValues(scalar_vars, vector_vars, varInfoList, modelVarList, q, active);
+	}
+
+	static inline void submit(std::vector<typeScalar> &scalar_vars, std::vector<typeVector> &vector_vars,
+			const std::vector<variable_info<dim> > &varInfoList, const std::vector<modelResidual<dim> > &modelResidualsList, const unsigned int q,
+			const std::vector<bool> &active){
+		if (!active[var]) {
+			// vanishing sparse variable
+		}
+		else if (rhsVariableTypes.isScalar[var]) {
+			typeScalar &fe_eval = scalar_vars[varInfoList[var].scalar_or_vector_index];
+			if (rhsValueResidual[var]) fe_eval.submit_value(modelResidualsList[var].scalarValueResidual,q);
+			if (rhsGradientResidual[var]) fe_eval.submit_gradient(modelResidualsList[var].scalarGradResidual,q);
+		}
+		else {
+			typeVector &fe_eval = vector_vars[varInfoList[var].scalar_or_vector_index];
+			if (rhsValueResidual[var]) fe_eval.submit_value(modelResidualsList[var].vectorValueResidual,q);
+			if (rhsGradientResidual[var]) fe_eval.submit_gradient(modelResidualsList[var].vectorGradResidual,q);
+		}
+		next::submit(scalar_vars, vector_vars, varInfoList, modelResidualsList, q, active);
+	}
+
+	static inline void integrate(std::vector<typeScalar> &scalar_vars, std::vector<typeVector> &vector_vars,
+			const std::vector<variable_info<dim> > &varInfoList, std::vector<vectorType*> &dst, const std::vector<bool> &active){
+		if (!active[var]) {
+			// vanishing sparse variable
+		}
+		else if (rhsVariableTypes.isScalar[var]) {
+			typeScalar &fe_eval = scalar_vars[varInfoList[var].scalar_or_vector_index];
+			fe_eval.integrate(rhsValueResidual[var], rhsGradientResidual[var]);
+			fe_eval.distribute_local_to_global(*dst[varInfoList[var].global_var_index]);
+		}
+		else {
+			typeVector &fe_eval = vector_vars[varInfoList[var].scalar_or_vector_index];
+			fe_eval.integrate(rhsValueResidual[var], rhsGradientResidual[var]);
+			fe_eval.distribute_local_to_global(*dst[varInfoList[var].global_var_index]);
+		}
+		next::integrate(scalar_vars, vector_vars, varInfoList, dst, active);
+	}
+};
+
+// End of the loop over the variables
+template <int dim, unsigned int n_var>
+struct rhsVariableLoop<dim,n_var,n_var>
+{
+	static inline void evaluate(std::vector<typeScalar> &, std::vector<typeVector> &,
+			const std::vector<variable_info<dim> > &, const std::vector<vectorType*> &, const unsigned int,
+			std::vector<modelVariable<dim> > &, std::vector<bool> &){}
+	static inline void getValues(const std::vector<typeScalar> &, const std::vector<typeVector> &,
+			const std::vector<variable_info<dim> > &, std::vector<modelVariable<dim> > &, const unsigned int,
+			const std::vector<bool> &){}
+	static inline void submit(std::vector<typeScalar> &, std::vector<typeVector> &,
+			const std::vector<variable_info<dim> > &, const std::vector<modelResidual<dim> > &, const unsigned int,
+			const std::vector<bool> &){}
+	static inline void integrate(std::vector<typeScalar> &, std::vector<typeVector> &,
+			const std::vector<variable_info<dim> > &, std::vector<vectorType*> &, const std::vector<bool> &){}
+};
+
+template <int dim>
+void generalizedProblem<dim>::getRHS(const MatrixFree<dim,numberType> &data,
 					       std::vector<vectorType*> &dst,
 					       const std::vector<vectorType*> &src,
 					       const std::pair<unsigned int,unsigned int> &cell_range) const{
 
+  typedef rhsVariableLoop<dim,0,num_var> variableLoop;
 
-  //initialize FEEvaulation objects
-  std::vector<typeScalar> scalar_vars;
-  std::vector<typeVector> vector_vars;
-
-  for (unsigned int i=0; i<num_var; i++){
-	  if (varInfoListRHS[i].is_scalar){
-		  typeScalar var(data, i);
-		  scalar_vars.push_back(var);
-	  }
-	  else {
-		  typeVector var(data, i);
-		  vector_vars.push_back(var);
-	  }
-  }
-
-  std::vector<modelVariable<dim> > modelVarList;
-  std::vector<modelResidual<dim> > modelResidualsList;
-  modelVarList.reserve(num_var);
-  modelResidualsList.reserve(num_var);
+  //FEEvaulation objects of this thread
+  evaluatorPool &pool = getEvaluatorPool(data, false);
+  std::vector<typeScalar> &scalar_vars = pool.scalar_vars;
+  std::vector<typeVector> &vector_vars = pool.vector_vars;
+  std::vector<modelVariable<dim> > &modelVarList = pool.modelVarList;
+  std::vector<modelResidual<dim> > &modelResidualsList = pool.modelResidualsList;
+  std::vector<bool> &active = pool.activeVariables;
 
   //loop over cells
   for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
 
-	  // Initialize, read DOFs, and set evaulation flags for each variable
-	  for (unsigned int i=0; i<num_var; i++){
-		  if (varInfoListRHS[i].is_scalar) {
-			  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].reinit(cell);
-			  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].read_dof_values_plain(*src[varInfoListRHS[i].global_var_index]);
-			  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].evaluate(need_value[i], need_gradient[i], need_hessian[i]);
-		  }
-		  else {
-			  vector_vars[varInfoListRHS[i].scalar_or_vector_index].reinit(cell);
-			  vector_vars[varInfoListRHS[i].scalar_or_vector_index].read_dof_values_plain(*src[varInfoListRHS[i].global_var_index]);
-			  vector_vars[varInfoListRHS[i].scalar_or_vector_index].evaluate(need_value[i], need_gradient[i], need_hessian[i]);
-		  }
-	  }
+	  // Cell batches outside the active region (activeRegionSkipping)
+	  if (!this->isActiveCellBatch(cell)) continue;
 
-	  unsigned int num_q_points;
-	  if (scalar_vars.size() > 0){
-		  num_q_points = scalar_vars[0].n_q_points;
-	  }
-	  else {
-		  num_q_points = vector_vars[0].n_q_points;
-	  }
+	  // Initialize, read DOFs, and set evaulation flags for each variable
+	  variableLoop::evaluate(scalar_vars, vector_vars, varInfoListRHS, src, cell, modelVarList, active);
 
 	  //loop over quadrature points
-	  for (unsigned int q=0; q<num_q_points; ++q){
+	  for (unsigned int q=0; q<typeScalar::n_q_points; ++q){
 
-		  dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc;
+		  dealii::Point<dim, scalarType> q_point_loc;
 		  if (scalar_vars.size() > 0){
 			  q_point_loc = scalar_vars[0].quadrature_point(q);
 		  }
@@ -267,202 +453,384 @@ void generalizedProblem<dim>::getRHS(const MatrixFree<dim,double> &data,
 			  q_point_loc = vector_vars[0].quadrature_point(q);
 		  }
 
-		  for (unsigned int i=0; i<num_var; i++){
-			  if (varInfoListRHS[i].is_scalar) {
-				  if (need_value[i]){
-					  modelVarList[i].scalarValue = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
-				  }
-				  if (need_gradient[i]){
-					  modelVarList[i].scalarGrad = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
-				  }
-				  if (need_hessian[i]){
-					  modelVarList[i].scalarHess = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
-				  }
-			  }
-			  else {
-				  if (need_value[i]){
-					  modelVarList[i].vectorValue = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
-				  }
-				  if (need_gradient[i]){
-					  modelVarList[i].vectorGrad = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
-				  }
-				  if (need_hessian[i]){
-					  modelVarList[i].vectorHess = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
-				  }
-			  }
-		  }
+		  variableLoop::getValues(scalar_vars, vector_vars, varInfoListRHS, modelVarList, q, active);
 
 		  // Calculate the residuals
 		  residualRHS(modelVarList,modelResidualsList,q_point_loc);
 
 		  // Submit values
-		  for (unsigned int i=0; i<num_var; i++){
-			  if (varInfoListRHS[i].is_scalar) {
-				  if (value_residual[i] == true){
-					  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].submit_value(modelResidualsList[i].scalarValueResidual,q);
-				  }
-      			  if (gradient_residual[i] == true){
-      				  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].submit_gradient(modelResidualsList[i].scalarGradResidual,q);
-      			  }
-      		  }
-      		  else {
-      			  if (value_residual[i] == true){
-      				  vector_vars[varInfoListRHS[i].scalar_or_vector_index].submit_value(modelResidualsList[i].vectorValueResidual,q);
-      			  }
-      			  if (gradient_residual[i] == true){
-      				  vector_vars[varInfoListRHS[i].scalar_or_vector_index].submit_gradient(modelResidualsList[i].vectorGradResidual,q);
-      			  }
-      		  }
-      	  }
-
+		  variableLoop::submit(scalar_vars, vector_vars, varInfoListRHS, modelResidualsList, q, active);
 	  }
 
-	  for (unsigned int i=0; i<num_var; i++){
-		  if (varInfoListRHS[i].is_scalar) {
-			  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].integrate(value_residual[i], gradient_residual[i]);
-			  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].distribute_local_to_global(*dst[varInfoListRHS[i].global_var_index]);
-		  }
-		  else {
-			  vector_vars[varInfoListRHS[i].scalar_or_vector_index].integrate(value_residual[i], gradient_residual[i]);
-			  vector_vars[varInfoListRHS[i].scalar_or_vector_index].distribute_local_to_global(*dst[varInfoListRHS[i].global_var_index]);
-		  }
-	  }
+	  variableLoop::integrate(scalar_vars, vector_vars, varInfoListRHS, dst, active);
   }
 }
 
+// Copy the quadrature point values of a variable needed by getLHS to or from the cache. The tensors are stored as
+// consecutive VectorizedArray entries.
+template <typename T>
+inline void storeLHSCacheEntry(const T &x, scalarType* &cache){
+	const scalarType *entries = reinterpret_cast<const scalarType *>(&x);
+	for (unsigned int i=0; i<sizeof(T)/sizeof(scalarType); i++){
+		*cache++ = entries[i];
+	}
+}
+
+template <typename T>
+inline void loadLHSCacheEntry(T &x, const scalarType* &cache){
+	scalarType *entries = reinterpret_cast<scalarType *>(&x);
+	for (unsigned int i=0; i<sizeof(T)/sizeof(scalarType); i++){
+		entries[i] = *cache++;
+	}
+}
+
+// Number of cache entries per quadrature point of a variable of the LHS
 template <int dim>
-void  generalizedProblem<dim>::getLHS(const MatrixFree<dim,double> &data,
-					       vectorType &dst,
-					       const vectorType &src,
-					       const std::pair<unsigned int,unsigned int> &cell_range) const{
+unsigned int generalizedProblem<dim>::getLHSCacheEntries(const variable_info<dim> &varInfo) const{
+	const unsigned int i = varInfo.global_var_index;
+	unsigned int n_entries = 0;
+	if (varInfo.is_scalar){
+		if (need_value_LHS[i]) n_entries += sizeof(scalarvalueType);
+		if (need_gradient_LHS[i]) n_entries += sizeof(scalargradType);
+		if (need_hessian_LHS[i]) n_entries += sizeof(scalarhessType);
+	}
+	else {
+		if (need_value_LHS[i]) n_entries += sizeof(vectorvalueType);
+		if (need_gradient_LHS[i]) n_entries += sizeof(vectorgradType);
+		if (need_hessian_LHS[i]) n_entries += sizeof(vectorhessType);
+	}
+	return n_entries/sizeof(scalarType);
+}
 
-	variable_info<dim> resInfoLHS;
+// Evaluate the fields that are not solved for at the quadrature points of all the cells, before an implicit solve of the
+// field fieldIndex. These fields are constant during the solve, so getLHS then only has to evaluate src.
+template <int dim>
+void generalizedProblem<dim>::cacheLHSFields(unsigned int fieldIndex){
+	if (lhsFieldCacheSet.size() != var_name.size()){
+		lhsFieldCacheSet.resize(var_name.size());
+		lhsFieldCacheEntriesSet.resize(var_name.size());
+	}
+	std::vector<scalarType> &cache = lhsFieldCacheSet[fieldIndex];
+
+	// Number of entries per quadrature point, without the field being solved
+	unsigned int n_entries = 0;
 	for (unsigned int i=0; i<num_var_LHS; i++){
-		if (MatrixFreePDE<dim>::currentFieldIndex == varInfoListLHS[i].global_var_index){
-			resInfoLHS = varInfoListLHS[i];
+		if (varInfoListLHS[i].global_var_index != fieldIndex){
+			n_entries += getLHSCacheEntries(varInfoListLHS[i]);
 		}
 	}
+	lhsFieldCacheEntriesSet[fieldIndex] = n_entries;
+	if (n_entries == 0){
+		cache.clear();
+		return;
+	}
 
-	//initialize FEEvaulation objects
-	std::vector<typeScalar> scalar_vars;
-	std::vector<typeVector> vector_vars;
+	const MatrixFree<dim,numberType> &data = this->matrixFreeObject;
+	const unsigned int num_q_points = typeScalar::n_q_points;
+	cache.resize(data.n_macro_cells()*num_q_points*n_entries);
 
+	evaluatorPool &pool = getEvaluatorPool(data, true);
+	scalarType *cache_entry = &cache[0];
+	for (unsigned int cell=0; cell<data.n_macro_cells(); ++cell){
+		scalarType *cell_cache = cache_entry + cell*num_q_points*n_entries;
+		unsigned int offset = 0;
+		for (unsigned int i=0; i<num_var_LHS; i++){
+			const unsigned int var = varInfoListLHS[i].global_var_index;
+			if (var == fieldIndex) continue;
+
+			if (varInfoListLHS[i].is_scalar){
+				typeScalar &fe_eval = pool.scalar_vars[varInfoListLHS[i].scalar_or_vector_index];
+				fe_eval.reinit(cell);
+				fe_eval.read_dof_values_plain(*this->solutionSet[var]);
+				fe_eval.evaluate(need_value_LHS[var], need_gradient_LHS[var], need_hessian_LHS[var]);
+				for (unsigned int q=0; q<num_q_points; ++q){
+					scalarType *q_cache = cell_cache + q*n_entries + offset;
+					if (need_value_LHS[var]) storeLHSCacheEntry(fe_eval.get_value(q), q_cache);
+					if (need_gradient_LHS[var]) storeLHSCacheEntry(fe_eval.get_gradient(q), q_cache);
+					if (need_hessian_LHS[var]) storeLHSCacheEntry(fe_eval.get_hessian(q), q_cache);
+				}
+			}
+			else {
+				typeVector &fe_eval = pool.vector_vars[varInfoListLHS[i].scalar_or_vector_index];
+				fe_eval.reinit(cell);
+				fe_eval.read_dof_values_plain(*this->solutionSet[var]);
+				fe_eval.evaluate(need_value_LHS[var], need_gradient_LHS[var], need_hessian_LHS[var]);
+				for (unsigned int q=0; q<num_q_points; ++q){
+					scalarType *q_cache = cell_cache + q*n_entries + offset;
+					if (need_value_LHS[var]) storeLHSCacheEntry(fe_eval.get_value(q), q_cache);
+					if (need_gradient_LHS[var]) storeLHSCacheEntry(fe_eval.get_gradient(q), q_cache);
+					if (need_hessian_LHS[var]) storeLHSCacheEntry(fe_eval.get_hessian(q), q_cache);
+				}
+			}
+			offset += getLHSCacheEntries(varInfoListLHS[i]);
+		}
+	}
+}
+
+// Discard the cache of the fields that are not solved for
+template <int dim>
+void generalizedProblem<dim>::clearLHSFieldCache(){
+	for (unsigned int i=0; i<lhsFieldCacheSet.size(); i++){
+		std::vector<scalarType>().swap(lhsFieldCacheSet[i]);
+	}
+}
+
+template <int dim>
+void  generalizedProblem<dim>::getLHS(const MatrixFree<dim,numberType> &data,
+					       vectorType &dst,
+					       const vectorType &src,
+					       const std::pair<unsigned int,unsigned int> &cell_range) const{
+	getLHSCells(data, dst, src, cell_range, this->currentFieldIndex, this->currentFieldIndex);
+}
+
+template <int dim>
+void  generalizedProblem<dim>::getLHSBlock(const MatrixFree<dim,numberType> &data,
+					       vectorType &dst,
+					       const vectorType &src,
+					       const std::pair<unsigned int,unsigned int> &cell_range,
+					       const unsigned int fieldIndex,
+					       const unsigned int srcFieldIndex) const{
+	getLHSCells(data, dst, src, cell_range, fieldIndex, srcFieldIndex);
+}
+
+template <int dim>
+void  generalizedProblem<dim>::getLHSSinglePrecision(const MatrixFree<dim,numberType> &data,
+					       floatVectorType &dst,
+					       const floatVectorType &src,
+					       const std::pair<unsigned int,unsigned int> &cell_range) const{
+	getLHSCells(data, dst, src, cell_range, this->currentFieldIndex, this->currentFieldIndex);
+}
+
+// Reinitializes the FEEvaluation objects of the LHS variables on a cell batch, and reads and evaluates the variables that are
+// not solved for (all but srcFieldIndex), unless they are read from the cache of cacheLHSFields()
+template <int dim>
+void generalizedProblem<dim>::evaluateLHSFields(evaluatorPool &pool, const std::vector<vectorType*> &fieldSet,
+		const unsigned int srcFieldIndex, const unsigned int cell, const bool use_cache) const{
 	for (unsigned int i=0; i<num_var_LHS; i++){
-		if (varInfoListLHS[i].is_scalar){
-			typeScalar var(data, varInfoListLHS[i].global_var_index);
-			scalar_vars.push_back(var);
+		const unsigned int var = varInfoListLHS[i].global_var_index;
+		if (varInfoListLHS[i].is_scalar) {
+			typeScalar &fe_eval = pool.scalar_vars[varInfoListLHS[i].scalar_or_vector_index];
+			fe_eval.reinit(cell);
+			if ((var != srcFieldIndex) && !use_cache){
+				fe_eval.read_dof_values_plain(*fieldSet[var]);
+				fe_eval.evaluate(need_value_LHS[var], need_gradient_LHS[var], need_hessian_LHS[var]);
+			}
 		}
 		else {
-			typeVector var(data, varInfoListLHS[i].global_var_index);
-			vector_vars.push_back(var);
+			typeVector &fe_eval = pool.vector_vars[varInfoListLHS[i].scalar_or_vector_index];
+			fe_eval.reinit(cell);
+			if ((var != srcFieldIndex) && !use_cache){
+				fe_eval.read_dof_values_plain(*fieldSet[var]);
+				fe_eval.evaluate(need_value_LHS[var], need_gradient_LHS[var], need_hessian_LHS[var]);
+			}
 		}
 	}
+}
 
-	std::vector<modelVariable<dim> > modelVarList;
-	modelVarList.reserve(num_var_LHS);
+// Evaluates residualLHS at the quadrature points of a cell batch, and submits and integrates the residual of the field of resInfoLHS
+// with respect to the change of the field srcFieldIndex. The FEEvaluation object of srcFieldIndex must hold the evaluated change,
+// the other variables are read from their FEEvaluation objects or, if cell_cache is not NULL, from the cache of cacheLHSFields().
+template <int dim>
+void generalizedProblem<dim>::submitLHSResiduals(evaluatorPool &pool, const variable_info<dim> &resInfoLHS, const unsigned int srcFieldIndex,
+		const scalarType *cell_cache, const unsigned int n_cache_entries) const{
+	std::vector<typeScalar> &scalar_vars = pool.scalar_vars;
+	std::vector<typeVector> &vector_vars = pool.vector_vars;
+	std::vector<modelVariable<dim> > &modelVarList = pool.modelVarList;
 	modelResidual<dim> modelRes;
+	modelRes.fieldIndex = resInfoLHS.global_var_index;
+	modelRes.changedFieldIndex = srcFieldIndex;
+
+	//loop over quadrature points
+	for (unsigned int q=0; q<typeScalar::n_q_points; ++q){
+		dealii::Point<dim, scalarType> q_point_loc;
+		if (resInfoLHS.is_scalar){
+			q_point_loc = scalar_vars[resInfoLHS.scalar_or_vector_index].quadrature_point(q);
+		}
+		else {
+			q_point_loc = vector_vars[resInfoLHS.scalar_or_vector_index].quadrature_point(q);
+		}
 
-	//loop over cells
-	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
-
-		// Initialize, read DOFs, and set evaulation flags for each variable
+		const scalarType *q_cache = (cell_cache != NULL ? cell_cache + q*n_cache_entries : NULL);
 		for (unsigned int i=0; i<num_var_LHS; i++){
-			if (varInfoListLHS[i].is_scalar) {
-				scalar_vars[varInfoListLHS[i].scalar_or_vector_index].reinit(cell);
-				if ( varInfoListLHS[i].global_var_index == resInfoLHS.global_var_index ){
-					scalar_vars[varInfoListLHS[i].scalar_or_vector_index].read_dof_values_plain(src);
+			const unsigned int var = varInfoListLHS[i].global_var_index;
+			if ((q_cache != NULL) && (var != srcFieldIndex)){
+				if (varInfoListLHS[i].is_scalar) {
+					if (need_value_LHS[var]) loadLHSCacheEntry(modelVarList[i].scalarValue(), q_cache);
+					if (need_gradient_LHS[var]) loadLHSCacheEntry(modelVarList[i].scalarGrad(), q_cache);
+					if (need_hessian_LHS[var]) loadLHSCacheEntry(modelVarList[i].scalarHess(), q_cache);
 				}
-				else{
-					scalar_vars[varInfoListLHS[i].scalar_or_vector_index].read_dof_values_plain(*MatrixFreePDE<dim>::solutionSet[varInfoListLHS[i].global_var_index]);
+				else {
+					if (need_value_LHS[var]) loadLHSCacheEntry(modelVarList[i].vectorValue(), q_cache);
+					if (need_gradient_LHS[var]) loadLHSCacheEntry(modelVarList[i].vectorGrad(), q_cache);
+					if (need_hessian_LHS[var]) loadLHSCacheEntry(modelVarList[i].vectorHess(), q_cache);
 				}
-				scalar_vars[varInfoListLHS[i].scalar_or_vector_index].evaluate(need_value_LHS[varInfoListLHS[i].global_var_index], need_gradient_LHS[varInfoListLHS[i].global_var_index], need_hessian_LHS[varInfoListLHS[i].global_var_index]);
+			}
+			else if (varInfoListLHS[i].is_scalar) {
+				const typeScalar &fe_eval = scalar_vars[varInfoListLHS[i].scalar_or_vector_index];
+				if (need_value_LHS[var]) modelVarList[i].scalarValue() = fe_eval.get_value(q);
+				if (need_gradient_LHS[var]) modelVarList[i].scalarGrad() = fe_eval.get_gradient(q);
+				if (need_hessian_LHS[var]) modelVarList[i].scalarHess() = fe_eval.get_hessian(q);
 			}
 			else {
-				vector_vars[varInfoListLHS[i].scalar_or_vector_index].reinit(cell);
-				if ( varInfoListLHS[i].global_var_index == resInfoLHS.global_var_index ){
-					vector_vars[varInfoListLHS[i].scalar_or_vector_index].read_dof_values_plain(src);
-				}
-				else {
-					vector_vars[varInfoListLHS[i].scalar_or_vector_index].read_dof_values_plain(*MatrixFreePDE<dim>::solutionSet[varInfoListLHS[i].global_var_index]);
-				}
-				vector_vars[varInfoListLHS[i].scalar_or_vector_index].evaluate(need_value_LHS[varInfoListLHS[i].global_var_index], need_gradient_LHS[varInfoListLHS[i].global_var_index], need_hessian_LHS[varInfoListLHS[i].global_var_index]);
+				const typeVector &fe_eval = vector_vars[varInfoListLHS[i].scalar_or_vector_index];
+				if (need_value_LHS[var]) modelVarList[i].vectorValue() = fe_eval.get_value(q);
+				if (need_gradient_LHS[var]) modelVarList[i].vectorGrad() = fe_eval.get_gradient(q);
+				if (need_hessian_LHS[var]) modelVarList[i].vectorHess() = fe_eval.get_hessian(q);
 			}
 		}
 
-		unsigned int num_q_points;
-		if (scalar_vars.size() > 0){
-			num_q_points = scalar_vars[0].n_q_points;
+		// Calculate the residuals
+		residualLHS(modelVarList,modelRes,q_point_loc);
+
+		// Submit values
+		if (resInfoLHS.is_scalar){
+			typeScalar &fe_eval = scalar_vars[resInfoLHS.scalar_or_vector_index];
+			if (value_residual[resInfoLHS.global_var_index]) fe_eval.submit_value(modelRes.scalarValueResidual,q);
+			if (gradient_residual[resInfoLHS.global_var_index]) fe_eval.submit_gradient(modelRes.scalarGradResidual,q);
 		}
 		else {
-			num_q_points = vector_vars[0].n_q_points;
-		}
-
-		//loop over quadrature points
-	    for (unsigned int q=0; q<num_q_points; ++q){
-	    	dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc;
-	    	if (scalar_vars.size() > 0){
-	    		q_point_loc = scalar_vars[0].quadrature_point(q);
-	    	}
-	    	else {
-	    		q_point_loc = vector_vars[0].quadrature_point(q);
-	    	}
-
-	    	for (unsigned int i=0; i<num_var_LHS; i++){
-	    		if (varInfoListLHS[i].is_scalar) {
-	    			if (need_value_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].scalarValue = scalar_vars[varInfoListLHS[i].scalar_or_vector_index].get_value(q);
-	    			}
-	    			if (need_gradient_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].scalarGrad = scalar_vars[varInfoListLHS[i].scalar_or_vector_index].get_gradient(q);
-	    			}
-	    			if (need_hessian_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].scalarHess = scalar_vars[varInfoListLHS[i].scalar_or_vector_index].get_hessian(q);
-	    			}
-	    		}
-	    		else {
-	    			if (need_value_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].vectorValue = vector_vars[varInfoListLHS[i].scalar_or_vector_index].get_value(q);
-	    			}
-	    			if (need_gradient_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].vectorGrad = vector_vars[varInfoListLHS[i].scalar_or_vector_index].get_gradient(q);
-	    			}
-	    			if (need_hessian_LHS[varInfoListLHS[i].global_var_index]){
-	    				modelVarList[i].vectorHess = vector_vars[varInfoListLHS[i].scalar_or_vector_index].get_hessian(q);
-	    			}
-	    		}
-	    	}
-
-	    	// Calculate the residuals
-	    	residualLHS(modelVarList,modelRes,q_point_loc);
-
-	    	// Submit values
-			if (resInfoLHS.is_scalar){
-				if (value_residual[resInfoLHS.global_var_index]){
-					scalar_vars[resInfoLHS.scalar_or_vector_index].submit_value(modelRes.scalarValueResidual,q);
-				}
-				if (gradient_residual[resInfoLHS.global_var_index]){
-					scalar_vars[resInfoLHS.scalar_or_vector_index].submit_gradient(modelRes.scalarGradResidual,q);
+			typeVector &fe_eval = vector_vars[resInfoLHS.scalar_or_vector_index];
+			if (value_residual[resInfoLHS.global_var_index]) fe_eval.submit_value(modelRes.vectorValueResidual,q);
+			if (gradient_residual[resInfoLHS.global_var_index]) fe_eval.submit_gradient(modelRes.vectorGradResidual,q);
+		}
+	}
+
+	//integrate
+	if (resInfoLHS.is_scalar) {
+		scalar_vars[resInfoLHS.scalar_or_vector_index].integrate(value_residual[resInfoLHS.global_var_index], gradient_residual[resInfoLHS.global_var_index]);
+	}
+	else {
+		vector_vars[resInfoLHS.scalar_or_vector_index].integrate(value_residual[resInfoLHS.global_var_index], gradient_residual[resInfoLHS.global_var_index]);
+	}
+}
+
+// Variable information of the field solved for in the implicit solve of the field fieldIndex
+template <int dim>
+variable_info<dim> generalizedProblem<dim>::getLHSResidualInfo(const unsigned int fieldIndex) const{
+	variable_info<dim> resInfoLHS;
+	for (unsigned int i=0; i<num_var_LHS; i++){
+		if (fieldIndex == varInfoListLHS[i].global_var_index){
+			resInfoLHS = varInfoListLHS[i];
+		}
+	}
+	return resInfoLHS;
+}
+
+// Cell loop of the LHS operator of the residual equation of the field fieldIndex with respect to the change of the field srcFieldIndex,
+// given by src, for the double precision vectors of the implicit solves and the single precision vectors of the inner solves of the
+// mixed precision implicit solves (the other fields are always read from the double precision solution)
+template <int dim>
+template <typename Number>
+void  generalizedProblem<dim>::getLHSCells(const MatrixFree<dim,numberType> &data,
+					       dealii::parallel::distributed::Vector<Number> &dst,
+					       const dealii::parallel::distributed::Vector<Number> &src,
+					       const std::pair<unsigned int,unsigned int> &cell_range,
+					       const unsigned int fieldIndex,
+					       const unsigned int srcFieldIndex) const{
+
+	// The other fields are read from the level copies of the solution vectors if this is a multigrid level operator
+	const std::vector<vectorType*> & fieldSet = this->getLHSFieldSet(data);
+
+	const variable_info<dim> resInfoLHS = getLHSResidualInfo(fieldIndex);
+	const variable_info<dim> srcInfoLHS = getLHSResidualInfo(srcFieldIndex);
+
+	// The other fields are read from the cache built by cacheLHSFields(srcFieldIndex) if there is one (only on the active mesh)
+	const bool use_cache = (&data == &this->matrixFreeObject) && (srcFieldIndex < lhsFieldCacheSet.size()) && !lhsFieldCacheSet[srcFieldIndex].empty();
+	const unsigned int n_cache_entries = (use_cache ? lhsFieldCacheEntriesSet[srcFieldIndex] : 0);
+
+	//FEEvaulation objects of this thread
+	evaluatorPool &pool = getEvaluatorPool(data, true);
+
+	//loop over cells
+	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
+
+		// Initialize, read DOFs, and set evaulation flags for each variable
+		evaluateLHSFields(pool, fieldSet, srcFieldIndex, cell, use_cache);
+		if (srcInfoLHS.is_scalar) {
+			typeScalar &fe_eval = pool.scalar_vars[srcInfoLHS.scalar_or_vector_index];
+			fe_eval.read_dof_values_plain(src);
+			fe_eval.evaluate(need_value_LHS[srcFieldIndex], need_gradient_LHS[srcFieldIndex], need_hessian_LHS[srcFieldIndex]);
+		}
+		else {
+			typeVector &fe_eval = pool.vector_vars[srcInfoLHS.scalar_or_vector_index];
+			fe_eval.read_dof_values_plain(src);
+			fe_eval.evaluate(need_value_LHS[srcFieldIndex], need_gradient_LHS[srcFieldIndex], need_hessian_LHS[srcFieldIndex]);
+		}
+
+		// Calculate, submit and integrate the residuals
+		const scalarType *cell_cache = (use_cache ? &lhsFieldCacheSet[srcFieldIndex][cell*typeScalar::n_q_points*n_cache_entries] : NULL);
+		submitLHSResiduals(pool, resInfoLHS, srcFieldIndex, cell_cache, n_cache_entries);
+
+		if (resInfoLHS.is_scalar) {
+			pool.scalar_vars[resInfoLHS.scalar_or_vector_index].distribute_local_to_global(dst);
+		}
+		else {
+			pool.vector_vars[resInfoLHS.scalar_or_vector_index].distribute_local_to_global(dst);
+		}
+	}
+
+}
+
+// Diagonal of the LHS operator, computed by applying the cell operator to each unit vector of the cell
+template <int dim>
+void  generalizedProblem<dim>::getLHSDiagonal(const MatrixFree<dim,numberType> &data,
+					       vectorType &dst,
+					       const vectorType &,
+					       const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+	const std::vector<vectorType*> & fieldSet = this->getLHSFieldSet(data);
+
+	const unsigned int fieldIndex = MatrixFreePDE<dim>::currentFieldIndex;
+	const variable_info<dim> resInfoLHS = getLHSResidualInfo(fieldIndex);
+
+	//FEEvaulation objects of this thread
+	evaluatorPool &pool = getEvaluatorPool(data, true);
+
+	const unsigned int dofs_per_cell = data.get_dof_handler(fieldIndex).get_fe().dofs_per_cell;
+	AlignedVector<scalarType> diagonal(dofs_per_cell);
+
+	//loop over cells
+	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
+
+		// Initialize all the variables, read DOFs and evaluate the variables that are not being solved for
+		evaluateLHSFields(pool, fieldSet, fieldIndex, cell, false);
+
+		// Apply the cell operator to each unit vector and keep the diagonal entry
+		for (unsigned int j=0; j<dofs_per_cell; j++){
+			if (resInfoLHS.is_scalar) {
+				typeScalar &fe_eval = pool.scalar_vars[resInfoLHS.scalar_or_vector_index];
+				for (unsigned int k=0; k<dofs_per_cell; k++){
+					fe_eval.begin_dof_values()[k] = make_vectorized_array<numberType>(j==k ? 1.0 : 0.0);
 				}
+				fe_eval.evaluate(need_value_LHS[fieldIndex], need_gradient_LHS[fieldIndex], need_hessian_LHS[fieldIndex]);
+				submitLHSResiduals(pool, resInfoLHS, fieldIndex, NULL, 0);
+				diagonal[j] = fe_eval.begin_dof_values()[j];
 			}
 			else {
-				if (value_residual[resInfoLHS.global_var_index]){
-					vector_vars[resInfoLHS.scalar_or_vector_index].submit_value(modelRes.vectorValueResidual,q);
-				}
-				if (gradient_residual[resInfoLHS.global_var_index]){
-					vector_vars[resInfoLHS.scalar_or_vector_index].submit_gradient(modelRes.vectorGradResidual,q);
+				typeVector &fe_eval = pool.vector_vars[resInfoLHS.scalar_or_vector_index];
+				for (unsigned int k=0; k<dofs_per_cell; k++){
+					fe_eval.begin_dof_values()[k] = make_vectorized_array<numberType>(j==k ? 1.0 : 0.0);
 				}
+				fe_eval.evaluate(need_value_LHS[fieldIndex], need_gradient_LHS[fieldIndex], need_hessian_LHS[fieldIndex]);
+				submitLHSResiduals(pool, resInfoLHS, fieldIndex, NULL, 0);
+				diagonal[j] = fe_eval.begin_dof_values()[j];
 			}
+		}
 
-	    }
-
-	    //integrate
+		//distribute the diagonal entries
 		if (resInfoLHS.is_scalar) {
-			scalar_vars[resInfoLHS.scalar_or_vector_index].integrate(value_residual[resInfoLHS.global_var_index], gradient_residual[resInfoLHS.global_var_index]);
-			scalar_vars[resInfoLHS.scalar_or_vector_index].distribute_local_to_global(dst);
+			typeScalar &fe_eval = pool.scalar_vars[resInfoLHS.scalar_or_vector_index];
+			for (unsigned int j=0; j<dofs_per_cell; j++){
+				fe_eval.begin_dof_values()[j] = diagonal[j];
+			}
+			fe_eval.distribute_local_to_global(dst);
 		}
 		else {
-			vector_vars[resInfoLHS.scalar_or_vector_index].integrate(value_residual[resInfoLHS.global_var_index], gradient_residual[resInfoLHS.global_var_index]);
-			vector_vars[resInfoLHS.scalar_or_vector_index].distribute_local_to_global(dst);
+			typeVector &fe_eval = pool.vector_vars[resInfoLHS.scalar_or_vector_index];
+			for (unsigned int j=0; j<dofs_per_cell; j++){
+				fe_eval.begin_dof_values()[j] = diagonal[j];
+			}
+			fe_eval.distribute_local_to_global(dst);
 		}
 	}
 
@@ -470,36 +838,23 @@ void  generalizedProblem<dim>::getLHS(const MatrixFree<dim,double> &data,
 
 // Calculate the free energy
 template <int dim>
-void  generalizedProblem<dim>::getEnergy(const MatrixFree<dim,double> &data,
+void  generalizedProblem<dim>::getEnergy(const MatrixFree<dim,numberType> &data,
 				    std::vector<vectorType*> &dst,
 				    const std::vector<vectorType*> &src,
 				    const std::pair<unsigned int,unsigned int> &cell_range) {
 
-	//initialize FEEvaulation objects
-	  std::vector<typeScalar> scalar_vars;
-	  std::vector<typeVector> vector_vars;
-
-	  for (unsigned int i=0; i<num_var; i++){
-		  if (varInfoListRHS[i].is_scalar){
-			  typeScalar var(data, i);
-			  scalar_vars.push_back(var);
-		  }
-		  else {
-			  typeVector var(data, i);
-			  vector_vars.push_back(var);
-		  }
-	  }
-
-	  std::vector<modelVariable<dim> > modelVarList;
-	  std::vector<modelResidual<dim> > modelResidualsList;
-	  modelVarList.reserve(num_var);
-	  modelResidualsList.reserve(num_var);
+	//FEEvaulation objects of this thread
+	  evaluatorPool &pool = getEvaluatorPool(data, false);
+	  std::vector<typeScalar> &scalar_vars = pool.scalar_vars;
+	  std::vector<typeVector> &vector_vars = pool.vector_vars;
+	  std::vector<modelVariable<dim> > &modelVarList = pool.modelVarList;
 
 	  //loop over cells
 	  for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
 
-		  // Initialize, read DOFs, and set evaulation flags for each variable
+		  // Initialize, read DOFs, and set evaulation flags for each variable (all the variables are evaluated)
 		  for (unsigned int i=0; i<num_var; i++){
+			  modelVarList[i].setActive(true);
 			  if (varInfoListRHS[i].is_scalar) {
 				  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].reinit(cell);
 				  scalar_vars[varInfoListRHS[i].scalar_or_vector_index].read_dof_values_plain(*src[varInfoListRHS[i].global_var_index]);
@@ -521,7 +876,7 @@ void  generalizedProblem<dim>::getEnergy(const MatrixFree<dim,double> &data,
 			  num_q_points = vector_vars[0].n_q_points;
 		  }
 
-		  dealii::AlignedVector<dealii::VectorizedArray<double> > JxW(num_q_points);
+		  dealii::AlignedVector<scalarType> &JxW = pool.JxW;
 
 		  if (scalar_vars.size() > 0){
 			  scalar_vars[0].fill_JxW_values(JxW);
@@ -532,7 +887,7 @@ void  generalizedProblem<dim>::getEnergy(const MatrixFree<dim,double> &data,
 
 		  //loop over quadrature points
 		  for (unsigned int q=0; q<num_q_points; ++q){
-			  dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc;
+			  dealii::Point<dim, scalarType> q_point_loc;
 			  if (scalar_vars.size() > 0){
 				  q_point_loc = scalar_vars[0].quadrature_point(q);
 			  }
@@ -543,24 +898,24 @@ void  generalizedProblem<dim>::getEnergy(const MatrixFree<dim,double> &data,
 			  for (unsigned int i=0; i<num_var; i++){
 				  if (varInfoListRHS[i].is_scalar) {
 					  if (need_value[i]){
-						  modelVarList[i].scalarValue = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
+						  modelVarList[i].scalarValue() = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
 					  }
 					  if (need_gradient[i]){
-						  modelVarList[i].scalarGrad = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
+						  modelVarList[i].scalarGrad() = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
 					  }
 					  if (need_hessian[i]){
-						  modelVarList[i].scalarHess = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
+						  modelVarList[i].scalarHess() = scalar_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
 					  }
 				  }
 				  else {
 					  if (need_value[i]){
-						  modelVarList[i].vectorValue = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
+						  modelVarList[i].vectorValue() = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_value(q);
 					  }
 					  if (need_gradient[i]){
-						  modelVarList[i].vectorGrad = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
+						  modelVarList[i].vectorGrad() = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_gradient(q);
 					  }
 					  if (need_hessian[i]){
-						  modelVarList[i].vectorHess = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
+						  modelVarList[i].vectorHess() = vector_vars[varInfoListRHS[i].scalar_or_vector_index].get_hessian(q);
 					  }
 				  }
 			  }
@@ -624,12 +979,18 @@ void generalizedProblem<dim>::adaptiveRefine(unsigned int currentIncrement){
 		}
 	}
 	else if ( (currentIncrement%skipRemeshingSteps==0) ){
+		if (!adaptiveRemeshing || this->isRemeshingRequired()){
 			this->reinit();
 		}
+	}
 	#endif
 }
 
 //adaptive refinement criterion
+//A cell is flagged for refinement if the value of one of the refineCriterionFields lies inside (refineWindowMin, refineWindowMax)
+//at one of its quadrature points, or if the optional refineGradientMin is defined and the gradient magnitude of a field exceeds its
+//entry there, and flagged for coarsening otherwise. The fields are evaluated with FEEvaluation on the cell batches of the matrix
+//free object and the flags are set on the cells of the lanes.
 template <int dim>
 void generalizedProblem<dim>::adaptiveRefineCriterion(){
 #if hAdaptivity == true
@@ -637,63 +998,63 @@ void generalizedProblem<dim>::adaptiveRefineCriterion(){
 	std::vector<int> refine_criterion_fields;
 	std::vector<double> refine_window_max;
 	std::vector<double> refine_window_min;
+	std::vector<double> refine_gradient_min;
 	{int temp[] = refineCriterionFields;
 	vectorLoad(temp, sizeof(temp), refine_criterion_fields);}
 	{double temp[] = refineWindowMax;
 	vectorLoad(temp, sizeof(temp), refine_window_max);}
 	{double temp[] = refineWindowMin;
 	vectorLoad(temp, sizeof(temp), refine_window_min);}
-
-	std::vector<std::vector<double> > errorOutV;
-
-
-	QGauss<dim>  quadrature(finiteElementDegree+1);
-	FEValues<dim> fe_values (*this->FESet[refine_criterion_fields[0]], quadrature, update_values);
-	const unsigned int   num_quad_points = quadrature.size();
-
-	std::vector<double> errorOut(num_quad_points);
-
-	typename DoFHandler<dim>::active_cell_iterator cell = this->dofHandlersSet_nonconst[refine_criterion_fields[0]]->begin_active(), endc = this->dofHandlersSet_nonconst[refine_criterion_fields[0]]->end();
-
-	for (;cell!=endc; ++cell){
-		if (cell->is_locally_owned()){
-			fe_values.reinit (cell);
-
-			for (unsigned int field_index=0; field_index<refine_criterion_fields.size(); field_index++){
-				fe_values.get_function_values(*this->solutionSet[refine_criterion_fields[field_index]], errorOut);
-				errorOutV.push_back(errorOut);
-			}
-
-			bool mark_refine = false;
-
-			for (unsigned int q_point=0; q_point<num_quad_points; ++q_point){
-				for (unsigned int field_index=0; field_index<refine_criterion_fields.size(); field_index++){
-					if ((errorOutV[field_index][q_point]>refine_window_min[field_index]) && (errorOutV[field_index][q_point]<refine_window_max[field_index])){
-						mark_refine = true;
-						break;
+	#ifdef refineGradientMin
+	{double temp[] = refineGradientMin;
+	vectorLoad(temp, sizeof(temp), refine_gradient_min);}
+	if (refine_gradient_min.size() != refine_criterion_fields.size()){
+		this->pcout << "\nError: refineGradientMin needs one entry for each of the refineCriterionFields.\n\n";
+		exit(-1);
+	}
+	#endif
+	const bool use_gradient = !refine_gradient_min.empty();
+
+	// Refinement flag of each lane of each cell batch
+	const unsigned int n_cells = this->matrixFreeObject.n_macro_cells();
+	const unsigned int n_lanes = scalarType::n_array_elements;
+	std::vector<bool> mark_refine(n_cells*n_lanes, false);
+
+	for (unsigned int field_index=0; field_index<refine_criterion_fields.size(); field_index++){
+		const unsigned int fieldIndex = refine_criterion_fields[field_index];
+		// Evaluated at the Gauss points (quadrature index 1 of the matrix free object), as with FEValues and QGauss
+		typeScalar fe_eval(this->matrixFreeObject, fieldIndex, 1);
+		const scalarType window_min = constV(refine_window_min[field_index]), window_max = constV(refine_window_max[field_index]);
+		for (unsigned int cell=0; cell<n_cells; ++cell){
+			fe_eval.reinit(cell);
+			fe_eval.read_dof_values_plain(*this->solutionSet[fieldIndex]);
+			fe_eval.evaluate(true, use_gradient);
+			for (unsigned int q=0; q<fe_eval.n_q_points; ++q){
+				const scalarType value = fe_eval.get_value(q);
+				scalarType gradient_norm2 = constV(0.0);
+				if (use_gradient){
+					gradient_norm2 = fe_eval.get_gradient(q).norm_square();
+				}
+				for (unsigned int lane=0; lane<this->matrixFreeObject.n_components_filled(cell); lane++){
+					if (((value[lane] > window_min[lane]) && (value[lane] < window_max[lane])) ||
+							(use_gradient && (gradient_norm2[lane] > refine_gradient_min[field_index]*refine_gradient_min[field_index]))){
+						mark_refine[cell*n_lanes+lane] = true;
 					}
 				}
 			}
+		}
+	}
 
-			errorOutV.clear();
-
-//			fe_values.get_function_values(*this->solutionSet[refine_criterion_fields[0]], errorOut);
-//
-//			bool mark_refine = false;
-//
-//			for (unsigned int q_point=0; q_point<num_quad_points; ++q_point){
-//				if ((errorOut[q_point]>refine_window_min[0]) && (errorOut[q_point]<refine_window_max[0])){
-//					mark_refine = true;
-//					break;
-//				}
-//			}
-
-
-			if ( (mark_refine == true) ){
-				cell->set_refine_flag();
+	// Flag the cells of the lanes
+	const unsigned int fieldIndex0 = refine_criterion_fields[0];
+	for (unsigned int cell=0; cell<n_cells; ++cell){
+		for (unsigned int lane=0; lane<this->matrixFreeObject.n_components_filled(cell); lane++){
+			typename DoFHandler<dim>::cell_iterator dof_cell = this->matrixFreeObject.get_cell_iterator(cell, lane, fieldIndex0);
+			if (mark_refine[cell*n_lanes+lane]){
+				dof_cell->set_refine_flag();
 			}
 			else {
-				cell->set_coarsen_flag();
+				dof_cell->set_coarsen_flag();
 			}
 		}
 	}
@@ -968,6 +1329,59 @@ void generalizedProblem<dim>::applyDirichletBCs(){
   }
 }
 
+// Level DOFs with Dirichlet BCs, used by the multigrid preconditioner
+template <int dim>
+void generalizedProblem<dim>::getLevelDirichletIndices(std::vector<IndexSet> & levelDirichletIndices){
+
+  // First, get the variable index of the current field
+  unsigned int starting_BC_list_index = 0;
+
+  for (unsigned int i=0; i<this->currentFieldIndex; i++){
+
+	  if (var_type[i] == "SCALAR"){
+		  starting_BC_list_index++;
+	  }
+	  else {
+		  starting_BC_list_index+=dim;
+	  }
+  }
+
+  unsigned int num_components = 1;
+  if (var_type[this->currentFieldIndex] == "VECTOR"){
+	  num_components = dim;
+  }
+
+  for (unsigned int direction = 0; direction < 2*dim; direction++){
+
+	  std::vector<bool> mask;
+	  bool has_Dirichlet_BC = false;
+	  for (unsigned int component=0; component < num_components; component++){
+		  if (BC_list[starting_BC_list_index+component].var_BC_type[direction] == "DIRICHLET"){
+			  mask.push_back(true);
+			  has_Dirichlet_BC = true;
+		  }
+		  else {
+			  mask.push_back(false);
+		  }
+	  }
+
+	  if (has_Dirichlet_BC){
+		  std::set<types::boundary_id> boundary_ids;
+		  boundary_ids.insert(direction);
+
+		  std::vector<IndexSet> boundary_indices(levelDirichletIndices.size());
+		  for (unsigned int level=0; level<levelDirichletIndices.size(); level++){
+			  boundary_indices[level].set_size(levelDirichletIndices[level].size());
+		  }
+		  MGTools::make_boundary_list (*this->dofHandlersSet[this->currentFieldIndex], boundary_ids, boundary_indices, ComponentMask(mask));
+
+		  for (unsigned int level=0; level<levelDirichletIndices.size(); level++){
+			  levelDirichletIndices[level].add_indices(boundary_indices[level]);
+		  }
+	  }
+  }
+}
+
 //methods to mark boundaries
 template <int dim>
 void generalizedProblem<dim>::markBoundaries(){
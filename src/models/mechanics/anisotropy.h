@@ -180,7 +180,7 @@ void getCIJMatrix(elasticityModel model, double constants[], dealii::Table<2, do
 }
 
 template <int dim>
-void getCIJMatrix(elasticityModel model, std::vector<double> constants, dealii::Tensor<2, 2*dim-1+dim/3, dealii::VectorizedArray<double> >& CIJ, dealii::ConditionalOStream& pcout){
+void getCIJMatrix(elasticityModel model, std::vector<double> constants, dealii::Tensor<2, 2*dim-1+dim/3, scalarType>& CIJ, dealii::ConditionalOStream& pcout){
   //CIJ.fill(0.0);
   pcout << "Reading material model:";
   switch (dim){
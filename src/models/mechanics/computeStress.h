@@ -40,9 +40,9 @@
 
 // Overloaded function where CIJ is a table, and the stress and strain are vectorized arrays
 template <int dim>
-void computeStress(const dealii::Table<2, double>& CIJ, const dealii::VectorizedArray<double> strain[][dim], dealii::VectorizedArray<double> R[][dim]){
+void computeStress(const dealii::Table<2, double>& CIJ, const scalarType strain[][dim], scalarType R[][dim]){
 if (dim==3){
-  dealii::VectorizedArray<double> S[6], E[6];
+  scalarType S[6], E[6];
   E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
   //In Voigt notation: Engineering shear strain=2*strain
   E[3]=strain[1][2]+strain[2][1];
@@ -59,7 +59,7 @@ if (dim==3){
   R[2][1]=S[3]; R[2][0]=S[4]; R[1][0]=S[5];
 
 //    Optimized algorithm that skips the zero entries of CIJ for an orthotropic material and is a few percent faster
-//	  dealii::VectorizedArray<double> S[6], E[6];
+//	  scalarType S[6], E[6];
 //	  E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
 //	  //In Voigt notation: Engineering shear strain=2*strain
 //	  E[3]=strain[1][2]+strain[2][1];
@@ -80,7 +80,7 @@ if (dim==3){
 //	  R[2][1]=S[3]; R[2][0]=S[4]; R[1][0]=S[5];
 }
 else if (dim==2){
-  dealii::VectorizedArray<double> S[3], E[3];
+  scalarType S[3], E[3];
   E[0]=strain[0][0]; E[1]=strain[1][1];
   //In Voigt notation: Engineering shear strain=2*strain
   E[2]=strain[0][1]+strain[1][0];
@@ -94,7 +94,7 @@ else if (dim==2){
   R[0][1]=S[2]; R[1][0]=S[2];
 }
 else {
-	dealii::VectorizedArray<double> S[1], E[1];
+	scalarType S[1], E[1];
 	E[0]=strain[0][0];
 	S[0]=CIJ(0,0)*E[0];
 	R[0][0]=S[0];
@@ -104,9 +104,9 @@ else {
 
 // Overloaded function where CIJ, the strain, and the stress are all vectorized arrays
 template <int dim>
-void computeStress(const dealii::VectorizedArray<double> CIJ[2*dim-1+dim/3][2*dim-1+dim/3], const dealii::VectorizedArray<double> strain[][dim], dealii::VectorizedArray<double> R[][dim]){
+void computeStress(const scalarType CIJ[2*dim-1+dim/3][2*dim-1+dim/3], const scalarType strain[][dim], scalarType R[][dim]){
 if (dim==3){
-  dealii::VectorizedArray<double> S[6], E[6];
+  scalarType S[6], E[6];
   E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
   //In Voigt notation: Engineering shear strain=2*strain
   E[3]=strain[1][2]+strain[2][1];
@@ -123,7 +123,7 @@ if (dim==3){
   R[2][1]=S[3]; R[2][0]=S[4]; R[1][0]=S[5];
 }
 else if (dim==2){
-  dealii::VectorizedArray<double> S[3], E[3];
+  scalarType S[3], E[3];
   E[0]=strain[0][0]; E[1]=strain[1][1];
   //In Voigt notation: Engineering shear strain=2*strain
   E[2]=strain[0][1]+strain[1][0];
@@ -137,7 +137,7 @@ else if (dim==2){
   R[0][1]=S[2]; R[1][0]=S[2];
 }
 else {
-	dealii::VectorizedArray<double> S[1], E[1];
+	scalarType S[1], E[1];
 	E[0]=strain[0][0];
 	S[0]=CIJ[0][0]*E[0];
 	R[0][0]=S[0];
@@ -147,9 +147,9 @@ else {
 
 // Overloaded function where CIJ is stored as a tensor and the strain and stress are vectorized arrays
 template <int dim>
-void computeStress(const dealii::Tensor<2, 2*dim-1+dim/3, dealii::VectorizedArray<double> >& CIJ, const dealii::VectorizedArray<double> strain[][dim], dealii::VectorizedArray<double> R[][dim]){
+void computeStress(const dealii::Tensor<2, 2*dim-1+dim/3, scalarType>& CIJ, const scalarType strain[][dim], scalarType R[][dim]){
 if (dim==3){
-  dealii::VectorizedArray<double> S[6], E[6];
+  scalarType S[6], E[6];
   E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
   //In Voigt notation: Engineering shear strain=2*strain
   E[3]=strain[1][2]+strain[2][1];
@@ -166,7 +166,7 @@ if (dim==3){
   R[2][1]=S[3]; R[2][0]=S[4]; R[1][0]=S[5];
 }
 else if (dim==2){
-  dealii::VectorizedArray<double> S[3], E[3];
+  scalarType S[3], E[3];
   E[0]=strain[0][0]; E[1]=strain[1][1];
   //In Voigt notation: Engineering shear strain=2*strain
   E[2]=strain[0][1]+strain[1][0];
@@ -180,7 +180,7 @@ else if (dim==2){
   R[0][1]=S[2]; R[1][0]=S[2];
 }
 else {
-	dealii::VectorizedArray<double> S[1], E[1];
+	scalarType S[1], E[1];
 	E[0]=strain[0][0];
 	S[0]=CIJ[0][0]*E[0];
 	R[0][0]=S[0];
@@ -190,9 +190,9 @@ else {
 
 // Overloaded function where CIJ, the strain, and the stress are all stored as tensors
 template <int dim>
-void computeStress(const dealii::Tensor<2, 2*dim-1+dim/3, dealii::VectorizedArray<double> >& CIJ, const dealii::Tensor<2, dim, dealii::VectorizedArray<double> > strain, dealii::Tensor<2, dim, dealii::VectorizedArray<double> >& R){
+void computeStress(const dealii::Tensor<2, 2*dim-1+dim/3, scalarType>& CIJ, const dealii::Tensor<2, dim, scalarType> strain, dealii::Tensor<2, dim, scalarType>& R){
 
-dealii::Tensor<1, 2*dim-1+dim/3, dealii::VectorizedArray<double> > S, E;
+dealii::Tensor<1, 2*dim-1+dim/3, scalarType> S, E;
 
 if (dim==3){
 	E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
@@ -227,9 +227,9 @@ else {
 
 // Overloaded function where CIJ is a table and the strain and the stress are stored as tensors
 template <int dim>
-void computeStress(const dealii::Table<2, double>& CIJ, const dealii::Tensor<2, dim, dealii::VectorizedArray<double> >& strain, dealii::Tensor<2, dim, dealii::VectorizedArray<double> >& R){
+void computeStress(const dealii::Table<2, double>& CIJ, const dealii::Tensor<2, dim, scalarType>& strain, dealii::Tensor<2, dim, scalarType>& R){
 if (dim==3){
-  dealii::VectorizedArray<double> S[6], E[6];
+  scalarType S[6], E[6];
   E[0]=strain[0][0]; E[1]=strain[1][1]; E[2]=strain[2][2];
   //In Voigt notation: Engineering shear strain=2*strain
   E[3]=strain[1][2]+strain[2][1];
@@ -246,7 +246,7 @@ if (dim==3){
   R[2][1]=S[3]; R[2][0]=S[4]; R[1][0]=S[5];
 }
 else if (dim==2){
-  dealii::VectorizedArray<double> S[3], E[3];
+  scalarType S[3], E[3];
   E[0]=strain[0][0]; E[1]=strain[1][1];
   //In Voigt notation: Engineering shear strain=2*strain
   E[2]=strain[0][1]+strain[1][0];
@@ -260,7 +260,7 @@ else if (dim==2){
   R[0][1]=S[2]; R[1][0]=S[2];
 }
 else {
-	dealii::VectorizedArray<double> S[1], E[1];
+	scalarType S[1], E[1];
 	E[0]=strain[0][0];
 	S[0]=CIJ[0][0]*E[0];
 	R[0][0]=S[0];
@@ -6,6 +6,17 @@
 // to reduce the number of steps the user needs to take. Currently this is only
 // implemented for scalar functions. Vector functions can be treated component by
 // component.
+//
+// A PFunction can optionally be tabulated on an interval as piecewise quintic Hermite
+// polynomials that match its value, first and second derivative at the interval ends.
+// The number of intervals is doubled until the value, gradient and Hessian of the
+// table differ from those of the PFunction by less than the given tolerance (relative
+// to the largest magnitude of each on the interval) at the quarter points of every
+// interval. The error is only sampled at these points, so the tolerance is a sampled
+// bound rather than a guaranteed one between them. Inside the interval all the lanes
+// of a vectorized array are then evaluated together, outside of it the PFunction is
+// called for each lane. Only functions of one input variable can be tabulated, and
+// their derivatives are then taken with respect to that variable (direction 0).
 
 namespace PFunctions{
 
@@ -15,6 +26,9 @@ public:
 	// Constructor, wraps the IntegrationTools checkout function
 	pFunction(std::string function_name);
 
+	// Constructor that also tabulates the function on [x_min,x_max] to the given relative tolerance
+	pFunction(std::string function_name, double x_min, double x_max, double tolerance);
+
 	// Returns the value of the function for a given input variable
 	scalarvalueType val(scalarvalueType);
 
@@ -24,18 +38,165 @@ public:
 	// Returns one of the second derivatives of the function for a given input variable
 	scalarvalueType hess(scalarvalueType, unsigned int, unsigned int);
 
+	// Tabulates the function of one variable on [x_min,x_max] to the given relative tolerance (checked at sample points)
+	void tabulate(double x_min, double x_max, double tolerance);
+
 private:
 	PRISMS::PFunction<double*, double> fun;
+
+	// Table of the polynomial coefficients (in the local coordinate of each interval, six per interval)
+	bool tabulated;
+	double table_min, table_max, table_h;
+	std::vector<double> coefficients;
+
+	// Builds the table for n_intervals intervals, returns the largest relative error at the check points
+	double buildTable(double x_min, double x_max, unsigned int n_intervals);
+
+	// Evaluates the derivative of the given order (0, 1 or 2) of the table, or the function for the lanes outside the table
+	scalarvalueType evaluate(const scalarvalueType &, unsigned int order);
+
+	// Derivative of the given order of the PFunction at a point
+	double exact(double x, unsigned int order);
+
+	// Stops with an error for a derivative of a tabulated function in a direction other than its single input variable
+	void checkTabulatedDirection(unsigned int dir);
 };
 
-pFunction::pFunction(std::string function_name){
+pFunction::pFunction(std::string function_name):tabulated(false){
 	PRISMS::PLibrary::checkout(function_name, fun);
 }
 
+pFunction::pFunction(std::string function_name, double x_min, double x_max, double tolerance):tabulated(false){
+	PRISMS::PLibrary::checkout(function_name, fun);
+	tabulate(x_min, x_max, tolerance);
+}
+
+double pFunction::exact(double x, unsigned int order){
+	if (order == 0) return fun(&x);
+	else if (order == 1) return fun.grad(&x,0);
+	else return fun.hess(&x,0,0);
+}
+
+void pFunction::checkTabulatedDirection(unsigned int dir){
+	if (dir != 0){
+		std::cout << "\nError: a tabulated PFunction has one input variable, its derivatives can only be taken in direction 0 (not " << dir << ").\n\n";
+		exit(-1);
+	}
+}
+
+double pFunction::buildTable(double x_min, double x_max, unsigned int n_intervals){
+	const double h = (x_max-x_min)/n_intervals;
+
+	// Values and derivatives (scaled to the local coordinate) at the nodes
+	std::vector<double> f(n_intervals+1), d(n_intervals+1), s(n_intervals+1);
+	double scale[3] = {0.0, 0.0, 0.0};
+	for (unsigned int i=0; i<=n_intervals; i++){
+		const double x = x_min + i*h;
+		f[i] = exact(x,0);
+		d[i] = exact(x,1);
+		s[i] = exact(x,2);
+		scale[0] = std::max(scale[0], std::abs(f[i]));
+		scale[1] = std::max(scale[1], std::abs(d[i]));
+		scale[2] = std::max(scale[2], std::abs(s[i]));
+		d[i] *= h;
+		s[i] *= h*h;
+	}
+
+	coefficients.resize(6*n_intervals);
+	for (unsigned int i=0; i<n_intervals; i++){
+		double *a = &coefficients[6*i];
+		a[0] = f[i];
+		a[1] = d[i];
+		a[2] = 0.5*s[i];
+		const double A = f[i+1]-(a[0]+a[1]+a[2]);
+		const double B = d[i+1]-(a[1]+2.0*a[2]);
+		const double C = s[i+1]-2.0*a[2];
+		a[3] = 10.0*A - 4.0*B + 0.5*C;
+		a[4] = -15.0*A + 7.0*B - C;
+		a[5] = 6.0*A - 3.0*B + 0.5*C;
+	}
+
+	table_min = x_min;
+	table_max = x_max;
+	table_h = h;
+
+	// Largest error at the quarter points, relative to the largest magnitude of the value, gradient and Hessian
+	double max_error = 0.0;
+	for (unsigned int i=0; i<n_intervals; i++){
+		const double *a = &coefficients[6*i];
+		for (unsigned int q=1; q<4; q++){
+			const double t = 0.25*q;
+			double approx[3];
+			approx[0] = a[0]+t*(a[1]+t*(a[2]+t*(a[3]+t*(a[4]+t*a[5]))));
+			approx[1] = (a[1]+t*(2.0*a[2]+t*(3.0*a[3]+t*(4.0*a[4]+t*5.0*a[5]))))/h;
+			approx[2] = (2.0*a[2]+t*(6.0*a[3]+t*(12.0*a[4]+t*20.0*a[5])))/(h*h);
+			for (unsigned int order=0; order<3; order++){
+				const double error = std::abs(approx[order]-exact(x_min+(i+t)*h,order));
+				max_error = std::max(max_error, error/(scale[order] > 0.0 ? scale[order] : 1.0));
+			}
+		}
+	}
+	return max_error;
+}
+
+void pFunction::tabulate(double x_min, double x_max, double tolerance){
+	if (fun.var_name().size() != 1){
+		std::cout << "\nError: only PFunctions of one input variable can be tabulated (" << fun.name() << " has " << fun.var_name().size() << ").\n\n";
+		exit(-1);
+	}
+	const unsigned int max_intervals = 1 << 20;
+	unsigned int n_intervals = 16;
+	double error = buildTable(x_min, x_max, n_intervals);
+	while ((error > tolerance) && (n_intervals < max_intervals)){
+		n_intervals *= 2;
+		error = buildTable(x_min, x_max, n_intervals);
+	}
+	if (error > tolerance){
+		std::cout << "\nError: the PFunction could not be tabulated to the tolerance " << tolerance << " (error with " << n_intervals << " intervals: " << error << ").\n\n";
+		exit(-1);
+	}
+	tabulated = true;
+}
+
+scalarvalueType pFunction::evaluate(const scalarvalueType &var, unsigned int order){
+	// Local coordinate and coefficients of the interval of each lane
+	scalarvalueType t, a[6];
+	bool outside[scalarvalueType::n_array_elements];
+	for (unsigned i=0; i < var.n_array_elements; i++){
+		const double x = var[i];
+		outside[i] = !((x >= table_min) && (x <= table_max));
+		const double local = (outside[i] ? 0.0 : (x-table_min)/table_h);
+		const unsigned int interval = std::min((unsigned int) local, (unsigned int) (coefficients.size()/6-1));
+		t[i] = local-interval;
+		for (unsigned int k=0; k<6; k++){
+			a[k][i] = coefficients[6*interval+k];
+		}
+	}
+
+	scalarvalueType result;
+	if (order == 0){
+		result = a[0]+t*(a[1]+t*(a[2]+t*(a[3]+t*(a[4]+t*a[5]))));
+	}
+	else if (order == 1){
+		result = (a[1]+t*(constV(2.0)*a[2]+t*(constV(3.0)*a[3]+t*(constV(4.0)*a[4]+t*constV(5.0)*a[5]))))*constV(1.0/table_h);
+	}
+	else {
+		result = (constV(2.0)*a[2]+t*(constV(6.0)*a[3]+t*(constV(12.0)*a[4]+t*constV(20.0)*a[5])))*constV(1.0/(table_h*table_h));
+	}
+
+	for (unsigned i=0; i < var.n_array_elements; i++){
+		if (outside[i]) result[i] = exact(var[i],order);
+	}
+	return result;
+}
+
 scalarvalueType pFunction::val(scalarvalueType var){
+	if (tabulated) return evaluate(var,0);
+
 	scalarvalueType fun_val;
 	for (unsigned i=0; i < var.n_array_elements; i++){
-		fun_val[i] = fun(&var[i]);
+		double var_i = var[i];
+		fun_val[i] = fun(&var_i);
 	}
 	return fun_val;
 
@@ -43,9 +204,15 @@ scalarvalueType pFunction::val(scalarvalueType var){
 
 
 scalarvalueType pFunction::grad(scalarvalueType var,unsigned int dir){
+	if (tabulated){
+		checkTabulatedDirection(dir);
+		return evaluate(var,1);
+	}
+
 	scalarvalueType fun_grad;
 	for (unsigned i=0; i <var.n_array_elements; i++){
-		fun_grad[i] = fun.grad(&var[i],dir);
+		double var_i = var[i];
+		fun_grad[i] = fun.grad(&var_i,dir);
 	}
 	return fun_grad;
 
@@ -53,9 +220,16 @@ scalarvalueType pFunction::grad(scalarvalueType var,unsigned int dir){
 
 
 scalarvalueType pFunction::hess(scalarvalueType var,unsigned int dir1, unsigned int dir2){
+	if (tabulated){
+		checkTabulatedDirection(dir1);
+		checkTabulatedDirection(dir2);
+		return evaluate(var,2);
+	}
+
 	scalarvalueType fun_hess;
 	for (unsigned i=0; i < var.n_array_elements; i++){
-		fun_hess[i] = fun.hess(&var[i],dir1,dir2);
+		double var_i = var[i];
+		fun_hess[i] = fun.hess(&var_i,dir1,dir2);
 	}
 	return fun_hess;
 
@@ -28,18 +28,18 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVariablesList[0].vectorGrad;
+vectorgradType ux = modelVariablesList[0].vectorGrad();
 vectorgradType Rux;
 
 
 
 
-dealii::VectorizedArray<double> sfts[dim][dim];
+scalarType sfts[dim][dim];
 
-dealii::VectorizedArray<double> dist, a;
+scalarType dist, a;
 
 a = constV(10.0);
 
@@ -62,7 +62,7 @@ for (unsigned int i=0; i<dim; i++){
 
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i])-sfts[i][j];
@@ -86,14 +86,14 @@ modelResidualsList[0].vectorGradResidual = Rux;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVarList[0].vectorGrad;
+vectorgradType ux = modelVarList[0].vectorGrad();
 vectorgradType Rux;
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i]);
@@ -115,14 +115,14 @@ modelRes.vectorGradResidual = Rux;
 }
 
 template <int dim>
-void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const dealii::VectorizedArray<double> & JxW_value, dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList, const scalarType & JxW_value, dealii::Point<dim, scalarType> q_point_loc) {
 
 	//u
-	vectorgradType ux = modelVarList[0].vectorGrad;
+	vectorgradType ux = modelVarList[0].vectorGrad();
 
-	dealii::VectorizedArray<double> sfts[dim][dim];
+	scalarType sfts[dim][dim];
 
-	dealii::VectorizedArray<double> dist;
+	scalarType dist;
 
 	dist = std::sqrt((q_point_loc[0]-constV(0.0))*(q_point_loc[0]-constV(0.0))
 						+(q_point_loc[1]-constV(0.0))*(q_point_loc[1]-constV(0.0))
@@ -143,7 +143,7 @@ void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim>
 
 
 	//compute strain tensor
-	dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+	scalarType E[dim][dim], S[dim][dim];
 	for (unsigned int i=0; i<dim; i++){
 		for (unsigned int j=0; j<dim; j++){
 			E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i])-sfts[i][j];
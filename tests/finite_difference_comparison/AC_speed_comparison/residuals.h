@@ -26,11 +26,11 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 //n
-scalarvalueType n = modelVariablesList[0].scalarValue;
-scalargradType nx = modelVariablesList[0].scalarGrad;
+scalarvalueType n = modelVariablesList[0].scalarValue();
+scalargradType nx = modelVariablesList[0].scalarGrad();
 
 
 
@@ -42,18 +42,18 @@ modelResidualsList[0].scalarGradResidual = rnxV;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 }
 
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 	scalarvalueType total_energy_density = constV(0.0);
 
 //n
-scalarvalueType n = modelVarList[0].scalarValue;
-scalargradType nx = modelVarList[0].scalarGrad;
+scalarvalueType n = modelVarList[0].scalarValue();
+scalargradType nx = modelVarList[0].scalarGrad();
 
 
 scalarvalueType f_chem = fV;
@@ -79,17 +79,17 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 // The order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n = modelVariablesList[0].scalarValue;
-scalargradType nx = modelVariablesList[0].scalarGrad;
+scalarvalueType n = modelVariablesList[0].scalarValue();
+scalargradType nx = modelVariablesList[0].scalarGrad();
 
-vectorvalueType vec1 = modelVariablesList[1].vectorValue;
-vectorgradType vec1x = modelVariablesList[1].vectorGrad;
+vectorvalueType vec1 = modelVariablesList[1].vectorValue();
+vectorgradType vec1x = modelVariablesList[1].vectorGrad();
 
-vectorvalueType vec2 = modelVariablesList[2].vectorValue;
-vectorgradType vec2x = modelVariablesList[2].vectorGrad;
+vectorvalueType vec2 = modelVariablesList[2].vectorValue();
+vectorgradType vec2x = modelVariablesList[2].vectorGrad();
 
 
 // Residuals for the equation to evolve the order parameter (names here should match those in the macros above)
@@ -132,7 +132,7 @@ modelResidualsList[2].vectorGradResidual = rvecxV;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 }
 
 // =================================================================================
@@ -148,13 +148,13 @@ void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> >
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 scalarvalueType total_energy_density = constV(0.0);
 
 // The order parameter and its derivatives (names here should match those in the macros above)
-scalarvalueType n = modelVarList[0].scalarValue;
-scalargradType nx = modelVarList[0].scalarGrad;
+scalarvalueType n = modelVarList[0].scalarValue();
+scalargradType nx = modelVarList[0].scalarGrad();
 
 // The homogenous free energy
 scalarvalueType f_chem = fV;
@@ -61,18 +61,18 @@
 template <int dim>
 void generalizedProblem<dim>::residualRHS(const std::vector<modelVariable<dim> > & modelVariablesList,
 												std::vector<modelResidual<dim> > & modelResidualsList,
-												dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+												dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVariablesList[0].vectorGrad;
-vectorgradType u2x = modelVariablesList[1].vectorGrad;
-vectorgradType u3x = modelVariablesList[2].vectorGrad;
-scalargradType cx = modelVariablesList[3].scalarGrad;
+vectorgradType ux = modelVariablesList[0].vectorGrad();
+vectorgradType u2x = modelVariablesList[1].vectorGrad();
+vectorgradType u3x = modelVariablesList[2].vectorGrad();
+scalargradType cx = modelVariablesList[3].scalarGrad();
 vectorgradType Rux, Rux2;
 
 
 //compute strain tensor
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E[i][j]= constV(0.5)*(ux[i][j]+ux[j][i]);
@@ -81,7 +81,7 @@ for (unsigned int i=0; i<dim; i++){
 
 
 //compute strain tensor
-dealii::VectorizedArray<double> E2[dim][dim], S2[dim][dim];
+scalarType E2[dim][dim], S2[dim][dim];
 for (unsigned int i=0; i<dim; i++){
 	for (unsigned int j=0; j<dim; j++){
 		E2[i][j]= constV(0.5)*(u3x[i][j]+u3x[j][i]);
@@ -127,16 +127,16 @@ modelResidualsList[3].scalarGradResidual = -cx;
 template <int dim>
 void generalizedProblem<dim>::residualLHS(const std::vector<modelVariable<dim> > & modelVarList,
 		modelResidual<dim> & modelRes,
-		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+		dealii::Point<dim, scalarType> q_point_loc) const {
 
 //u
-vectorgradType ux = modelVarList[0].vectorGrad;
-vectorgradType u2x = modelVarList[1].vectorGrad;
-vectorgradType u3x = modelVarList[2].vectorGrad;
-scalargradType cx = modelVarList[3].scalarGrad;
+vectorgradType ux = modelVarList[0].vectorGrad();
+vectorgradType u2x = modelVarList[1].vectorGrad();
+vectorgradType u3x = modelVarList[2].vectorGrad();
+scalargradType cx = modelVarList[3].scalarGrad();
 vectorgradType Rux;
 
-dealii::VectorizedArray<double> E[dim][dim], S[dim][dim];
+scalarType E[dim][dim], S[dim][dim];
 if (this->currentFieldIndex == 0){
 	//compute strain tensor
 	for (unsigned int i=0; i<dim; i++){
@@ -185,8 +185,8 @@ else {
 // index 1: gradient energy, index 2: elastic energy).
 template <int dim>
 void generalizedProblem<dim>::energyDensity(const std::vector<modelVariable<dim> > & modelVarList,
-											const dealii::VectorizedArray<double> & JxW_value,
-											dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) {
+											const scalarType & JxW_value,
+											dealii::Point<dim, scalarType> q_point_loc) {
 
 }
 
@@ -125,6 +125,18 @@ int main(int argc, char **argv)
   unitTest<2,double> vectorLoad_tester_double;
   pass = vectorLoad_tester_double.test_vectorLoad(double_array,double_array_size,double_num_array_elements);
   tests_passed += pass;
+
+  // Unit tests for the vectorized math functions (accuracy and timings)
+  total_tests++;
+  unitTest<2,double> vectorizedMath_tester;
+  pass = vectorizedMath_tester.test_vectorizedMath();
+  tests_passed += pass;
+
+  // Unit tests for the method "remapGrains" (two close grains of one order parameter, on all the processes)
+  total_tests++;
+  unitTest<2,double> remapGrains_tester;
+  pass = remapGrains_tester.test_remapGrains();
+  tests_passed += pass;
   
   // Print out results
   char buffer[100];
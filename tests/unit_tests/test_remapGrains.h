@@ -0,0 +1,129 @@
+// Unit test(s) for the method "remapGrains"
+// Two grains of the first order parameter, closer than grainBufferDistance, on a mesh split over the processes. One of them (with
+// the tail of the order parameter around it) should be moved to the second order parameter, and the other one should stay.
+
+// Order parameter of the two grains, centered at (0.25,0.5) and (0.75,0.5)
+template <int dim>
+class twoGrains: public Function<dim>
+{
+ public:
+  twoGrains(): Function<dim>(1){};
+  double value(const Point<dim> &p, const unsigned int component = 0) const{
+	  Point<dim> left, right;
+	  left[0] = 0.25; right[0] = 0.75;
+	  for (unsigned int d=1; d<dim; d++){
+		  left[d] = 0.5; right[d] = 0.5;
+	  }
+	  const double r = std::min(p.distance(left), p.distance(right));
+	  return 0.5*(1.0-std::tanh((r-0.1)/0.02));
+  };
+};
+
+template <int dim>
+class testRemapGrains: public MatrixFreePDE<dim>
+{
+ public:
+  testRemapGrains(){
+
+	  // Two order parameters on a 20x20 mesh of the unit square
+	  this->fields.push_back(Field<problemDIM>(SCALAR,PARABOLIC,"n1"));
+	  this->fields.push_back(Field<problemDIM>(SCALAR,PARABOLIC,"n2"));
+
+	  std::vector<unsigned int> subdivisions(dim, 20);
+	  Point<dim> upper;
+	  for (unsigned int d=0; d<dim; d++){
+		  upper[d] = 1.0;
+	  }
+	  GridGenerator::subdivided_hyper_rectangle (this->triangulation, subdivisions, Point<dim>(), upper);
+
+	  for (unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+		  FESystem<dim>* fe=new FESystem<dim>(FE_Q<dim>(QGaussLobatto<1>(finiteElementDegree+1)),1);
+		  this->FESet.push_back(fe);
+		  DoFHandler<dim>* dof_handler=new DoFHandler<dim>(this->triangulation);
+		  this->dofHandlersSet.push_back(dof_handler);
+		  this->dofHandlersSet_nonconst.push_back(dof_handler);
+		  dof_handler->distribute_dofs (*fe);
+
+		  IndexSet* locally_relevant_dofs=new IndexSet;
+		  this->locally_relevant_dofsSet.push_back(locally_relevant_dofs);
+		  this->locally_relevant_dofsSet_nonconst.push_back(locally_relevant_dofs);
+		  DoFTools::extract_locally_relevant_dofs (*dof_handler, *locally_relevant_dofs);
+
+		  ConstraintMatrix *constraintsDirichlet=new ConstraintMatrix, *constraintsOther=new ConstraintMatrix;
+		  this->constraintsDirichletSet.push_back(constraintsDirichlet);
+		  this->constraintsDirichletSet_nonconst.push_back(constraintsDirichlet);
+		  this->constraintsOtherSet.push_back(constraintsOther);
+		  this->constraintsOtherSet_nonconst.push_back(constraintsOther);
+		  constraintsDirichlet->reinit(*locally_relevant_dofs);
+		  constraintsOther->reinit(*locally_relevant_dofs);
+		  DoFTools::make_hanging_node_constraints (*dof_handler, *constraintsOther);
+		  constraintsDirichlet->close();
+		  constraintsOther->close();
+	  }
+
+	  typename MatrixFree<dim,double>::AdditionalData additional_data;
+	  additional_data.mpi_communicator = MPI_COMM_WORLD;
+	  additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
+	  this->matrixFreeObject.reinit (this->dofHandlersSet, this->constraintsOtherSet, QGaussLobatto<1>(finiteElementDegree+1), additional_data);
+
+	  for (unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+		  vectorType *U=new vectorType, *R=new vectorType;
+		  this->solutionSet.push_back(U); this->residualSet.push_back(R);
+		  this->matrixFreeObject.initialize_dof_vector(*U, fieldIndex); *U=0;
+		  this->matrixFreeObject.initialize_dof_vector(*R, fieldIndex); *R=0;
+	  }
+	  VectorTools::interpolate (*this->dofHandlersSet[0], twoGrains<dim>(), *this->solutionSet[0]);
+
+	  //call remapGrains()
+	  this->remapGrains();
+
+	  // Largest value of each order parameter on the left and right halves of the domain
+	  std::map<types::global_dof_index, Point<dim> > support_points;
+	  DoFTools::map_dofs_to_support_points (MappingQ1<dim>(), *this->dofHandlersSet[0], support_points);
+	  std::vector<double> local_max(4, 0.0);
+	  for (unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+		  const vectorType &U = *this->solutionSet[fieldIndex];
+		  for (typename std::map<types::global_dof_index, Point<dim> >::const_iterator it=support_points.begin(); it!=support_points.end(); ++it){
+			  if (!U.in_local_range(it->first)) continue;
+			  const unsigned int half = (it->second[0] < 0.5 ? 0 : 1);
+			  local_max[2*fieldIndex+half] = std::max(local_max[2*fieldIndex+half], std::abs(U(it->first)));
+		  }
+	  }
+	  maxValues.resize(4);
+	  Utilities::MPI::max(local_max, MPI_COMM_WORLD, maxValues);
+
+	  // Need to clear fields or there's an error in the destructor
+	  this->fields.clear();
+  };
+  // Largest value of n1 on the left and right halves, then of n2
+  std::vector<double> maxValues;
+
+ private:
+  //RHS implementation for explicit solve
+  void getRHS(const MatrixFree<dim,double> &data,
+	      std::vector<vectorType*> &dst,
+	      const std::vector<vectorType*> &src,
+	      const std::pair<unsigned int,unsigned int> &cell_range) const{};
+
+};
+
+template <int dim,typename T>
+  bool unitTest<dim,T>::test_remapGrains(){
+	bool pass = false;
+	std::cout << "\nTesting 'remapGrains' in " << dim << " dimension(s)...'" << std::endl;
+
+	//create test problem class object
+	testRemapGrains<dim> test;
+
+	// One grain in each order parameter, and no tail of the moved grain left in n1
+	const std::vector<double> &m = test.maxValues;
+	const double tol = 1.0e-3;
+	const bool rightMoved = (m[0] > 0.5) && (m[1] < tol) && (m[2] < tol) && (m[3] > 0.5);
+	const bool leftMoved = (m[0] < tol) && (m[1] > 0.5) && (m[2] > 0.5) && (m[3] < tol);
+	if (rightMoved || leftMoved) {pass=true;}
+	char buffer[200];
+	sprintf (buffer, "Test result for 'remapGrains' in   %u dimension(s): %u (largest values n1: %g, %g, n2: %g, %g)\n", dim, pass, m[0], m[1], m[2], m[3]);
+	std::cout << buffer;
+
+	return pass;
+}
@@ -0,0 +1,117 @@
+// Unit test(s) for the vectorized math functions in "vectorizedMath.h"
+// Checks the largest relative error against the scalar functions and prints the time per lane
+// of the vectorized functions and of a loop over the lanes calling the scalar functions
+template <int dim, typename T>
+bool unitTest<dim,T>::test_vectorizedMath(){
+
+	bool pass = true;
+	std::cout << "Testing 'vectorizedMath'..." << std::endl;
+
+	typedef dealii::VectorizedArray<double> vArray;
+	const unsigned int n_lanes = vArray::n_array_elements;
+	const unsigned int n_samples = 100000;
+
+	// Arguments over several orders of magnitude and both signs
+	std::vector<vArray> x(n_samples), y(n_samples), xPositive(n_samples);
+	std::srand(1);
+	for (unsigned int n=0; n<n_samples; n++){
+		for (unsigned int i=0; i<n_lanes; i++){
+			const double magnitude = std::pow(10.0, (int)(std::rand()%6)-3);
+			x[n][i] = 2.0*magnitude*(std::rand()/(double)RAND_MAX-0.5);
+			y[n][i] = 2.0*magnitude*(std::rand()/(double)RAND_MAX-0.5);
+			xPositive[n][i] = std::abs(x[n][i])+1.0e-300;
+		}
+	}
+
+	// Largest relative errors of exp, log, pow, tanh and atan2 (exp and pow only where the result is a normal number)
+	const char *names[5] = {"exp", "log", "pow", "tanh", "atan2"};
+	const double tolerances[5] = {1.0e-15, 1.0e-15, 1.0e-13, 2.0e-15, 1.0e-15};
+	double max_error[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+	for (unsigned int n=0; n<n_samples; n++){
+		vArray values[5];
+		values[0] = vectorizedMath::exp(x[n]);
+		values[1] = vectorizedMath::log(xPositive[n]);
+		values[2] = vectorizedMath::pow(xPositive[n], 2.5);
+		values[3] = vectorizedMath::tanh(x[n]);
+		values[4] = vectorizedMath::atan2(y[n], x[n]);
+		for (unsigned int i=0; i<n_lanes; i++){
+			double exact[5];
+			exact[0] = std::exp(x[n][i]);
+			exact[1] = std::log(xPositive[n][i]);
+			exact[2] = std::pow(xPositive[n][i], 2.5);
+			exact[3] = std::tanh(x[n][i]);
+			exact[4] = std::atan2(y[n][i], x[n][i]);
+			for (unsigned int f=0; f<5; f++){
+				if ((std::abs(exact[f]) < std::numeric_limits<double>::min()) || (std::abs(exact[f]) > std::numeric_limits<double>::max())) continue;
+				max_error[f] = std::max(max_error[f], std::abs(values[f][i]-exact[f])/std::abs(exact[f]));
+			}
+		}
+	}
+
+	// Special values
+	vArray special = dealii::make_vectorized_array(0.0);
+	special[0] = -1.0;
+	if (n_lanes > 1) special[1] = std::numeric_limits<double>::infinity();
+	vArray special_log = vectorizedMath::log(special), special_tanh = vectorizedMath::tanh(special);
+	if (!(special_log[0] != special_log[0]) || (std::abs(special_tanh[0]-std::tanh(-1.0)) > 1.0e-15)){
+		pass = false;
+	}
+	if ((n_lanes > 1) && ((special_log[1] != std::numeric_limits<double>::infinity()) || (special_tanh[1] != 1.0))){
+		pass = false;
+	}
+	if ((vectorizedMath::exp(dealii::make_vectorized_array(-1000.0))[0] != 0.0) || (vectorizedMath::atan2(special, dealii::make_vectorized_array(-0.0))[n_lanes-1] != std::atan2(special[n_lanes-1], -0.0))){
+		pass = false;
+	}
+
+	for (unsigned int f=0; f<5; f++){
+		std::cout << "  " << names[f] << ": largest relative error " << max_error[f] << std::endl;
+		if (max_error[f] > tolerances[f]){
+			pass = false;
+		}
+	}
+
+	// Microbenchmark: vectorized functions against the scalar functions called lane by lane
+	const unsigned int n_repeats = 20;
+	vArray sum = dealii::make_vectorized_array(0.0);
+	for (unsigned int f=0; f<5; f++){
+		std::clock_t start = std::clock();
+		for (unsigned int r=0; r<n_repeats; r++){
+			for (unsigned int n=0; n<n_samples; n++){
+				if (f == 0) sum = sum + vectorizedMath::exp(y[n]);
+				else if (f == 1) sum = sum + vectorizedMath::log(xPositive[n]);
+				else if (f == 2) sum = sum + vectorizedMath::pow(xPositive[n], 2.5);
+				else if (f == 3) sum = sum + vectorizedMath::tanh(x[n]);
+				else sum = sum + vectorizedMath::atan2(y[n], x[n]);
+			}
+		}
+		const double vectorizedTime = (std::clock()-start)/(double)CLOCKS_PER_SEC;
+
+		start = std::clock();
+		for (unsigned int r=0; r<n_repeats; r++){
+			for (unsigned int n=0; n<n_samples; n++){
+				vArray value;
+				for (unsigned int i=0; i<n_lanes; i++){
+					if (f == 0) value[i] = std::exp(y[n][i]);
+					else if (f == 1) value[i] = std::log(xPositive[n][i]);
+					else if (f == 2) value[i] = std::pow(xPositive[n][i], 2.5);
+					else if (f == 3) value[i] = std::tanh(x[n][i]);
+					else value[i] = std::atan2(y[n][i], x[n][i]);
+				}
+				sum = sum + value;
+			}
+		}
+		const double scalarTime = (std::clock()-start)/(double)CLOCKS_PER_SEC;
+
+		char buffer[200];
+		sprintf(buffer, "  %s: %8.3f ns per value (vectorized), %8.3f ns per value (scalar)\n", names[f], \
+				1.0e9*vectorizedTime/(n_repeats*n_samples*n_lanes), 1.0e9*scalarTime/(n_repeats*n_samples*n_lanes));
+		std::cout << buffer;
+	}
+	if (sum[0] != sum[0]){
+		std::cout << "  (sum of the benchmark values is not finite)" << std::endl;
+	}
+
+	std::cout << "Test result for 'vectorizedMath': " << pass << std::endl;
+
+	return pass;
+}
@@ -1,5 +1,6 @@
 #include "../../include/dealIIheaders.h"
 #include <iostream>
+#include <ctime>
 
 #define problemDIM 2
 #define finiteElementDegree 1
@@ -17,6 +18,10 @@
 #define timeFinal 20.0
 #define timeIncrements 20000
 
+//define the grain remapping parameters for the remapGrains test
+#define grainRemappingFields {0,1}
+#define grainBufferDistance 0.3
+
 
 //define data type
 template <int dim>
@@ -39,6 +44,8 @@ class unitTest
 	bool test_getOutputTimeSteps(std::string,unsigned int, std::vector<unsigned int>);
 	bool test_setRigidBodyModeConstraints(std::vector<int>);
 	bool test_vectorLoad(T array[], int array_size, int num_array_elements);
+	bool test_vectorizedMath();
+	bool test_remapGrains();
 };
 
 
@@ -49,4 +56,6 @@ class unitTest
 #include "test_getOutputTimeSteps.h"
 #include "test_setRigidBodyModeConstraints.h"
 #include "test_vectorLoad.h"
+#include "test_vectorizedMath.h"
+#include "test_remapGrains.h"
 //#include "test_computeRHS.h"